@@ -0,0 +1,47 @@
+// Shared edge smoothing (FXAA-lite) for the light shaders.
+// Prepended to every light shader on load (see Light::set_shader); not a shader on its own.
+
+uniform bool fxaa; // enables edge smoothing
+
+const float FXAA_REDUCE_MIN = 1.0 / 128.0;
+const float FXAA_REDUCE_MUL = 1.0 / 8.0;
+const float FXAA_SPAN_MAX   = 8.0;
+
+// Samples the canvas; if fxaa is enabled, blurs along detected edges.
+vec4 sample_canvas(sampler2D canvas, vec2 canvas_size, vec2 px_pos)
+{
+    vec4 center = texture2D(canvas, px_pos);
+    if (!fxaa)
+        return center;
+
+    vec2 texel = 1.0 / canvas_size;
+    vec3 luma  = vec3(0.299, 0.587, 0.114);
+
+    float luma_nw = dot(texture2D(canvas, px_pos + vec2(-1.0,  1.0) * texel).rgb, luma);
+    float luma_ne = dot(texture2D(canvas, px_pos + vec2( 1.0,  1.0) * texel).rgb, luma);
+    float luma_sw = dot(texture2D(canvas, px_pos + vec2(-1.0, -1.0) * texel).rgb, luma);
+    float luma_se = dot(texture2D(canvas, px_pos + vec2( 1.0, -1.0) * texel).rgb, luma);
+    float luma_m  = dot(center.rgb, luma);
+
+    float luma_min = min(luma_m, min(min(luma_nw, luma_ne), min(luma_sw, luma_se)));
+    float luma_max = max(luma_m, max(max(luma_nw, luma_ne), max(luma_sw, luma_se)));
+
+    vec2 dir = vec2(-((luma_nw + luma_ne) - (luma_sw + luma_se)),
+                     ((luma_nw + luma_sw) - (luma_ne + luma_se)));
+
+    float dir_reduce = max((luma_nw + luma_ne + luma_sw + luma_se) * 0.25 * FXAA_REDUCE_MUL,
+                           FXAA_REDUCE_MIN);
+    float dir_min    = 1.0 / (min(abs(dir.x), abs(dir.y)) + dir_reduce);
+    dir = clamp(dir * dir_min, vec2(-FXAA_SPAN_MAX), vec2(FXAA_SPAN_MAX)) * texel;
+
+    vec4 a = 0.5 * (texture2D(canvas, px_pos + dir * (1.0 / 3.0 - 0.5)) +
+                    texture2D(canvas, px_pos + dir * (2.0 / 3.0 - 0.5)));
+    vec4 b = a * 0.5 + 0.25 * (texture2D(canvas, px_pos + dir * -0.5) +
+                               texture2D(canvas, px_pos + dir *  0.5));
+
+    float luma_b = dot(b.rgb, luma);
+    if (luma_b < luma_min || luma_b > luma_max)
+        return a;
+    return b;
+}
+
@@ -15,7 +15,7 @@ void main()
     float m = 1.0 / (1.0 + pow(x / 0.5, 6.0));
 
     vec2 px_pos = gl_FragCoord.xy / canvas_size;
-    vec4 outColor = texture2D(texture, px_pos);
+    vec4 outColor = sample_canvas(texture, canvas_size, px_pos);
     
     float grey = 0.2 * outColor.r + 0.7 * outColor.g + 0.2 * outColor.b;
 
@@ -1,5 +1,9 @@
 #include "app.h"
 
+#include <thread>
+#include <chrono>
+#include <SFML/OpenGL.hpp>
+
 #include "resources.h"
 #include "time_and_date.h"
 #include "logger.h"
@@ -7,6 +11,8 @@
 #include "convert.h"
 #include "maths.h"
 #include "colors.h"
+#include "file_watcher.h"
+#include "frame_profiler.h"
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -22,6 +28,14 @@ constexpr unsigned int MIN_WINDOW_HEIGHT = 500u;
 
 constexpr int MIN_FPS_CAP = 60;
 
+// The simulation always advances by this much (times the timeflow multiplier) per update;
+// frames in between are rendered by interpolating between the last two steps.
+constexpr Seconds SIMULATION_TIMESTEP = 1.f / 60.f;
+constexpr int     MAX_STEPS_PER_FRAME = 5;
+
+// While idle, frames are not rendered; the loop only polls for input and steps this often:
+constexpr Seconds IDLE_FRAME_INTERVAL = 1.f / 30.f;
+
 /*------------------------------------------------------------------------------------------------*/
 
 App::App() :
@@ -29,6 +43,8 @@ App::App() :
     mouse_hovering_window_area{ false },
     ignore_next_resize{ false },
     debug_components_initialized{ false },
+    frame_submitted{ false },
+    idle_frame_rendered{ false },
     timeflow_multiplier{ 1.0f },
     app_running{ true }
 {
@@ -39,8 +55,13 @@ App::App() :
         if (settings.debug)
             initialize_debug_components();
 
+        set_resource_budgets();
+
+        game.set_antialiasing(settings.antialiasing);
         create_window();
         AudioPlayer::instance().set_volume(settings.volume);
+        AudioPlayer::instance().set_voice_limit(settings.voice_limit);
+        AudioPlayer::instance().set_software_mixing(settings.software_mixing);
         load_global_sounds();
 
         game.initialize();
@@ -57,6 +78,7 @@ void App::run_loop()
     try
     {
         auto last_time_nanosec = Time::get_absolute_ns();
+        Seconds unsimulated_time = 0.f;
 
         while (app_running)
         {
@@ -65,12 +87,53 @@ void App::run_loop()
 
             last_time_nanosec = current_time_nanosec;
 
-            Seconds elapsed_time = static_cast<Seconds>(elapsed_time_nanosec * SECONDS_IN_NANOSECOND);
-            assure_less_than_or_equal_to(elapsed_time, 1.f / MIN_FPS_CAP);
-            elapsed_time *= timeflow_multiplier;
+            const Seconds frame_time = static_cast<Seconds>(elapsed_time_nanosec * SECONDS_IN_NANOSECOND);
+
+            // The simulation advances in fixed steps, regardless of the frame rate;
+            // after a very long frame, it falls behind rather than taking ever more steps to catch up:
+            unsimulated_time += frame_time;
+            assure_less_than_or_equal_to(unsimulated_time, MAX_STEPS_PER_FRAME * SIMULATION_TIMESTEP);
+
+            const bool events_received = handle_SFML_events();
+            {
+                SectionTimer timer{ FrameSection::Update };
+
+                while (unsimulated_time >= SIMULATION_TIMESTEP)
+                {
+                    game.save_interpolation_state();
+                    update(SIMULATION_TIMESTEP * timeflow_multiplier);
+                    unsimulated_time -= SIMULATION_TIMESTEP;
+
+                    // Presses and text input are consumed by a single step (held keys are polled):
+                    keyboard.reset_input();
+                    mouse.reset_wheel_input();
+                }
+
+                if (debug_components_initialized)
+                {
+                    fps_display.update(frame_time);
+                    frame_graph.update(frame_time);
+                }
+            }
+
+            // The previous frame was submitted before the steps above, so the GPU drew it while they
+            // were simulated; only what remains of the (vSync) wait is spent here:
+            present();
+
+            // A static frame is rendered once (as is, since it stays on screen), then the app sleeps;
+            // a swinging light is paused meanwhile, unless it is meant to keep the app from idling:
+            const bool idle = !events_received && is_idle();
+            game.set_light_swing_paused(idle && !settings.idle_light_swing);
+
+            if (!idle || !idle_frame_rendered)
+            {
+                render(idle ? 1.f : unsimulated_time / SIMULATION_TIMESTEP);
+                idle_frame_rendered = idle;
+            }
+            else
+                std::this_thread::sleep_for(std::chrono::duration<Seconds>(IDLE_FRAME_INTERVAL));
 
-            update(elapsed_time);
-            render();
+            FrameProfiler::instance().end_frame(frame_time);
         }
     }
     catch (const std::exception& e)
@@ -82,20 +145,18 @@ void App::run_loop()
 
 void App::update(const Seconds elapsed_time)
 {
-    handle_SFML_events();
-
     Executor::instance().update(elapsed_time);
     EARManager::instance().dispatch_queued_events();
 
     AudioPlayer::instance().update(elapsed_time);
-    update_resource_managers(elapsed_time);
+    update_resource_managers();
 
     mouse.update(elapsed_time);
     Cursor::instance().set_position(mouse.get_position_in_window());
     Cursor::instance().update(elapsed_time);
 
     if (debug_components_initialized)
-        fps_display.update(elapsed_time / timeflow_multiplier);
+        hot_reload_changed_files(elapsed_time / timeflow_multiplier);
 
     // Keyboard input:
     if (window.hasFocus())
@@ -117,11 +178,17 @@ void App::update(const Seconds elapsed_time)
             else if (keyboard.is_keybind_pressed(DebugKeybinds::TOGGLE_FPS_DISPLAY))
                 fps_display.toggle_visible();
 
+            else if (keyboard.is_keybind_pressed(DebugKeybinds::TOGGLE_FRAME_GRAPH))
+                frame_graph.toggle_visible();
+
             else if (keyboard.is_keybind_pressed(DebugKeybinds::RELOAD_TEXTURES))
                 TextureManager::instance().reload_all();
 
             else if (keyboard.is_keybind_pressed(DebugKeybinds::RELOAD_SOUNDBUFFERS))
+            {
+                AudioPlayer::instance().stop_mixed_sounds();
                 SoundBufferManager::instance().reload_all();
+            }
 
             debug_window.update_keyboard_input(keyboard);
         }
@@ -153,14 +220,17 @@ void App::update(const Seconds elapsed_time)
         window.setMouseCursorVisible(false);
 }
 
-void App::handle_SFML_events()
+bool App::handle_SFML_events()
 {
-    keyboard.reset_input();
-    mouse.reset_wheel_input();
+    // Note that input is reset once a simulation step has consumed it (see run_loop()),
+    // so that presses during frames without a step are not lost.
+    bool events_received = false;
 
     sf::Event event;
     while (window.pollEvent(event))
     {
+        events_received = true;
+
         if (event.type == sf::Event::Closed)
             EARManager::instance().queue_event(Event::FadeAndTerminate);
 
@@ -196,24 +266,65 @@ void App::handle_SFML_events()
                 mouse.set_wheel_ticks_delta(event.mouseWheelScroll.delta);
         }
     }
+
+    return events_received;
 }
 
-void App::render()
+bool App::is_idle() const
 {
+    // Debug components (FPS display, logs, etc.) are always considered active.
+    return settings.power_saving && !debug_components_initialized &&
+           !Executor::instance().is_busy() && Cursor::instance().is_idle() &&
+           game.is_idle(settings.idle_light_swing);
+}
+
+void App::hot_reload_changed_files(const Seconds elapsed_time)
+{
+    FileWatcher::instance().update(elapsed_time);
+
+    for (const auto& path : FileWatcher::instance().extract_changed_paths())
+    {
+        AudioPlayer::instance().stop_mixed_sounds(path);
+        reload_resource(path);
+        EARManager::instance().dispatch_event(Event::FileChanged, path);
+    }
+}
+
+void App::render(const float interpolation)
+{
+    SectionTimer timer{ FrameSection::Render };
+
     window.clear(Colors::BLACK);
 
-    game.render(window);
+    game.render(window, interpolation);
 
     if (debug_components_initialized)
     {
         window.draw(debug_window);
         window.draw(fps_display);
+        window.draw(frame_graph);
     }
 
     if (mouse_hovering_window_area)
+    {
+        // Follows the mouse every frame, not only every simulation step:
+        Cursor::instance().set_position(PxVec2{ sf::Mouse::getPosition(window) });
         window.draw(Cursor::instance());
+    }
 
+    // Draw calls may otherwise stay buffered by the driver until display():
+    glFlush();
+    frame_submitted = true;
+}
+
+void App::present()
+{
+    if (!frame_submitted)
+        return;
+
+    SectionTimer timer{ FrameSection::Display };
     window.display();
+    frame_submitted = false;
 }
 
 void App::on_resize()
@@ -254,7 +365,11 @@ void App::initialize_debug_components()
     debug_window.initialize();
     fps_display.initialize();
     fps_display.toggle_visible();
+    frame_graph.initialize();
+    FrameProfiler::instance().enable();
     game.initialize_debug_components();
+
+    FileWatcher::instance().enable();
 }
 
 void App::set_fps_cap(int fps_cap)
@@ -325,6 +440,37 @@ void App::set_audio_volume(int volume)
                                            "Audio enabled. Volume: " + Convert::to_str(volume));
 }
 
+void App::set_antialiasing(const std::string& mode)
+{
+    if (!contains(KNOWN_ANTIALIASING_MODES, get_decapitalized(mode)))
+    {
+        EARManager::instance().queue_event(Event::DisplayMessage,
+                                           "Unknown anti-aliasing mode: " + mode);
+        return;
+    }
+
+    settings.antialiasing = KNOWN_ANTIALIASING_MODES.at(get_decapitalized(mode));
+    game.set_antialiasing(settings.antialiasing);
+
+    EARManager::instance().queue_event(Event::DisplayMessage,
+                                       "Anti-aliasing set: " + get_decapitalized(mode));
+}
+
+void App::set_resource_budgets()
+{
+    // Non-positive budgets are invalid; fall back to keeping everything loaded.
+    const auto to_bytes = [](const int mebibytes)
+    {
+        return mebibytes > 0 ? static_cast<size_t>(mebibytes) * 1024u * 1024u : SIZE_MAX;
+    };
+
+    TextureManager::instance().set_byte_budget(to_bytes(settings.texture_budget));
+    SoundBufferManager::instance().set_byte_budget(to_bytes(settings.sound_budget));
+    FontManager::instance().set_byte_budget(to_bytes(settings.font_budget));
+    // Decoded images are textures yet to be uploaded (e.g. the table's tiles):
+    ImageManager::instance().set_byte_budget(to_bytes(settings.texture_budget));
+}
+
 void App::create_window()
 {
     if (settings.window_width == 0u || settings.window_height == 0u)
@@ -354,7 +500,7 @@ void App::create_window()
     window.setKeyRepeatEnabled(true);
 
     sf::Image icon;
-    if (icon.loadFromFile(WINDOW_ICON_PATH))
+    if (load_from_archive_or_drive(icon, WINDOW_ICON_PATH))
         window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
     else
         LOG_ALERT("window icon could not be loaded;\npath: " + WINDOW_ICON_PATH);
@@ -395,6 +541,9 @@ void App::on_event(const Event event, const Data& data)
     else if (event == Event::SetAudioVolume)
         set_audio_volume(data.as<int>());
 
+    else if (event == Event::SetAntiAliasing)
+        set_antialiasing(data.as<std::string>());
+
     else if (event == Event::SetTFMul)
     {
         float val = data.as<float>();
@@ -409,6 +558,7 @@ void App::on_event(const Event event, const Data& data)
             window.setMouseCursorVisible(true);
             window.clear(Colors::BLACK);
             window.display();
+            frame_submitted = false; // Its back buffer was just cleared and shown.
         }
         else if (mouse_hovering_window_area)
             window.setMouseCursorVisible(false);
@@ -431,4 +581,7 @@ void App::on_request(const Request request, Data& data)
 
     else if (request == Request::AudioVolume)
         data.set(settings.volume);
+
+    else if (request == Request::AntiAliasing)
+        data.set(Convert::enum_to_str(settings.antialiasing, KNOWN_ANTIALIASING_MODES));
 }
\ No newline at end of file
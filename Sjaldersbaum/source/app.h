@@ -4,6 +4,7 @@
 
 #include "app_settings.h"
 #include "fps_display.h"
+#include "frame_graph.h"
 #include "debug_window.h"
 #include "mouse.h"
 #include "keyboard.h"
@@ -22,11 +23,24 @@ public:
     void run_loop();
 
 private:
+    // Advances the simulation by a single (fixed) step.
     void update(Seconds elapsed_time_sec);
 
-    void handle_SFML_events();
+    // Returns true if any event (input, resizing, focus changes, etc.) was received.
+    bool handle_SFML_events();
 
-    void render();
+    // Power saving: returns true if nothing on screen changes over time, until there is input.
+    bool is_idle() const;
+
+    // Debug only. Reloads resources whose files changed, and notifies others (shaders, levels).
+    void hot_reload_changed_files(Seconds elapsed_time);
+
+    // Interpolation: see LevelPlayer::render().
+    // Only submits the frame; it is shown by present(), once the next steps are simulated.
+    void render(float interpolation);
+
+    // Displays the frame submitted by render(), if any.
+    void present();
 
     void on_resize();
 
@@ -42,6 +56,11 @@ private:
 
     void set_audio_volume(int volume);
 
+    void set_antialiasing(const std::string& mode);
+
+    // Applies the settings' memory budgets to the ResourceManagers.
+    void set_resource_budgets();
+
     void create_window();
 
     void save_and_terminate();
@@ -62,8 +81,12 @@ private:
 
     DebugWindow debug_window;
     FPS_Display fps_display;
+    FrameGraph frame_graph;
     bool debug_components_initialized;
 
+    bool frame_submitted;
+    bool idle_frame_rendered;
+
     float timeflow_multiplier;
     bool app_running;
 };
\ No newline at end of file
@@ -15,18 +15,57 @@ constexpr int  DEFAULT_FPS_CAP    = 0;
 constexpr bool DEFAULT_VSYNC      = true;
 constexpr bool DEFAULT_FULLSCREEN = false;
 constexpr int  DEFAULT_VOLUME     = 50;
+constexpr int  DEFAULT_VOICE_LIMIT = 32;
+constexpr bool DEFAULT_SOFTWARE_MIXING = false;
+constexpr bool DEFAULT_POWER_SAVING     = true;
+constexpr bool DEFAULT_IDLE_LIGHT_SWING = false;
+constexpr AntiAliasing DEFAULT_ANTIALIASING = AntiAliasing::MSAA4;
+constexpr int  DEFAULT_TEXTURE_BUDGET = 512;
+constexpr int  DEFAULT_SOUND_BUDGET   = 128;
+constexpr int  DEFAULT_FONT_BUDGET    = 32;
 constexpr bool DEFAULT_DEBUG_MODE = false;
 
 /*------------------------------------------------------------------------------------------------*/
 
+extern const std::unordered_map<std::string, AntiAliasing> KNOWN_ANTIALIASING_MODES
+{
+    { "off",    AntiAliasing::Off },
+    { "fxaa",   AntiAliasing::FXAA },
+    { "msaa2",  AntiAliasing::MSAA2 },
+    { "msaa4",  AntiAliasing::MSAA4 },
+    { "msaa8",  AntiAliasing::MSAA8 }
+};
+
+unsigned int get_msaa_level(const AntiAliasing antialiasing)
+{
+    if (antialiasing == AntiAliasing::MSAA2)
+        return 2u;
+    else if (antialiasing == AntiAliasing::MSAA4)
+        return 4u;
+    else if (antialiasing == AntiAliasing::MSAA8)
+        return 8u;
+    else
+        return 0u;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 AppSettings::AppSettings() :
-    window_width { DEFAULT_WINDOW_WIDTH },
-    window_height{ DEFAULT_WINDOW_HEIGHT },
-    fps_cap      { DEFAULT_FPS_CAP },
-    vsync        { DEFAULT_VSYNC },
-    fullscreen   { DEFAULT_FULLSCREEN },
-    volume       { DEFAULT_VOLUME },
-    debug        { DEFAULT_DEBUG_MODE }
+    window_width  { DEFAULT_WINDOW_WIDTH },
+    window_height { DEFAULT_WINDOW_HEIGHT },
+    fps_cap       { DEFAULT_FPS_CAP },
+    vsync         { DEFAULT_VSYNC },
+    fullscreen    { DEFAULT_FULLSCREEN },
+    volume        { DEFAULT_VOLUME },
+    voice_limit   { DEFAULT_VOICE_LIMIT },
+    software_mixing{ DEFAULT_SOFTWARE_MIXING },
+    power_saving  { DEFAULT_POWER_SAVING },
+    idle_light_swing{ DEFAULT_IDLE_LIGHT_SWING },
+    antialiasing  { DEFAULT_ANTIALIASING },
+    texture_budget{ DEFAULT_TEXTURE_BUDGET },
+    sound_budget  { DEFAULT_SOUND_BUDGET },
+    font_budget   { DEFAULT_FONT_BUDGET },
+    debug         { DEFAULT_DEBUG_MODE }
 {
 
 }
@@ -73,6 +112,30 @@ void AppSettings::load_from_file(const std::string& path)
             else if (key == "volume")
                 volume = value.as<int>();
 
+            else if (key == "voice_limit")
+                voice_limit = value.as<int>();
+
+            else if (key == "software_mixing")
+                software_mixing = value.as<bool>();
+
+            else if (key == "power_saving")
+                power_saving = value.as<bool>();
+
+            else if (key == "idle_light_swing")
+                idle_light_swing = value.as<bool>();
+
+            else if (key == "antialiasing")
+                antialiasing = Convert::str_to_enum(value.as<std::string>(), KNOWN_ANTIALIASING_MODES);
+
+            else if (key == "texture_budget")
+                texture_budget = value.as<int>();
+
+            else if (key == "sound_budget")
+                sound_budget = value.as<int>();
+
+            else if (key == "font_budget")
+                font_budget = value.as<int>();
+
             else if (key == "debug")
                 debug = value.as<bool>();
         }
@@ -91,13 +154,21 @@ void AppSettings::save_to_file(const std::string& path) const
     try
     {
         YAML::Node node;
-        node["window_width"]  = window_width;
-        node["window_height"] = window_height;
-        node["fps_cap"]       = fps_cap;
-        node["vsync"]         = vsync;
-        node["fullscreen"]    = fullscreen;
-        node["volume"]        = volume;
-        node["debug"]         = debug;
+        node["window_width"]   = window_width;
+        node["window_height"]  = window_height;
+        node["fps_cap"]        = fps_cap;
+        node["vsync"]          = vsync;
+        node["fullscreen"]     = fullscreen;
+        node["volume"]         = volume;
+        node["voice_limit"]    = voice_limit;
+        node["software_mixing"] = software_mixing;
+        node["power_saving"]   = power_saving;
+        node["idle_light_swing"] = idle_light_swing;
+        node["antialiasing"]   = Convert::enum_to_str(antialiasing, KNOWN_ANTIALIASING_MODES);
+        node["texture_budget"] = texture_budget;
+        node["sound_budget"]   = sound_budget;
+        node["font_budget"]    = font_budget;
+        node["debug"]          = debug;
         buffer << YAML::Dump(node);
     }
     catch (const YAML::Exception& e)
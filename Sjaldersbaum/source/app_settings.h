@@ -1,6 +1,26 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Anti-aliasing applied to the base canvas (see LevelPlayer).
+// MSAA is resolved by the GPU per canvas; FXAA is a cheap post-process folded into the light shader.
+enum class AntiAliasing
+{
+    Off,
+    FXAA,
+    MSAA2,
+    MSAA4,
+    MSAA8
+};
+
+// Modes: [off, fxaa, msaa2, msaa4, msaa8]
+extern const std::unordered_map<std::string, AntiAliasing> KNOWN_ANTIALIASING_MODES;
+
+// Returns the sample count used by sf::ContextSettings; 0 for non-MSAA modes.
+unsigned int get_msaa_level(AntiAliasing antialiasing);
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -20,5 +40,13 @@ public:
     bool vsync;
     bool fullscreen;
     int volume;
+    int voice_limit;    // Sounds that can play at once.
+    bool software_mixing;
+    bool power_saving;     // Sleep instead of rendering while nothing changes.
+    bool idle_light_swing; // A swinging light keeps the app from idling (power_saving).
+    AntiAliasing antialiasing;
+    int texture_budget; // MiB
+    int sound_budget;   // MiB
+    int font_budget;    // MiB
     bool debug;
 };
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "archive.h"
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "logger.h"
+#include "convert.h"
+#include "string_assist.h"
+
+namespace fs = std::filesystem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Archived paths are stored decapitalized, with forward slashes and without "./" or "..".
+std::string get_archive_key(const std::string& path)
+{
+    return get_decapitalized(fs::path{ path }.lexically_normal().generic_string());
+}
+
+// Returns true if path is in the form of an archived path already, so that it can be looked up
+// as is; e.g. paths interned by the ResourceManagers, which are decapitalized upon interning.
+bool is_archive_key(const std::string_view path)
+{
+    size_t segment_start = 0u;
+    for (size_t i = 0u; i <= path.size(); ++i)
+    {
+        if (i == path.size() || path[i] == '/')
+        {
+            const std::string_view segment = path.substr(segment_start, i - segment_start);
+            if (segment.empty() || segment == "." || segment == "..")
+                return false;
+            segment_start = i + 1u;
+        }
+        else if (path[i] == '\\' || std::isupper(static_cast<unsigned char>(path[i])))
+            return false;
+    }
+    return true;
+}
+
+// Maps the whole file at path into memory (read-only). Returns nullptr on failure.
+const std::uint8_t* map_file(const std::string& path, std::size_t& size)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    // The view keeps the mapping (and thus the file) alive by itself:
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(file);
+
+    size = static_cast<std::size_t>(file_size.QuadPart);
+    return static_cast<const std::uint8_t*>(view);
+#else
+    const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1)
+        return nullptr;
+
+    struct stat file_status;
+    if (fstat(file, &file_status) == -1 || file_status.st_size == 0)
+    {
+        close(file);
+        return nullptr;
+    }
+
+    size = static_cast<std::size_t>(file_status.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps the file alive by itself:
+    close(file);
+
+    return view == MAP_FAILED ? nullptr : static_cast<const std::uint8_t*>(view);
+#endif
+}
+
+void unmap_file(const std::uint8_t* data, const std::size_t size)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<std::uint8_t*>(data), size);
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+Archive& Archive::instance()
+{
+    static Archive singleton;
+    return singleton;
+}
+
+Archive::Archive() :
+    data{ nullptr },
+    size{ 0u }
+{
+
+}
+
+Archive::~Archive()
+{
+    unmount();
+}
+
+bool Archive::mount(const std::string& path)
+{
+    unmount();
+
+    data = map_file(path, size);
+    if (!data)
+        return false;
+
+    // Everything is validated up front, so that lookups never have to:
+    const auto fail = [this, &path](const std::string& reason)
+    {
+        LOG_ALERT("archive could not be mounted (" + reason + "):\n" + path);
+        unmount();
+        return false;
+    };
+
+    ArchiveHeader header;
+    if (size < sizeof(header))
+        return fail("truncated header");
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0)
+        return fail("not an archive");
+    if (header.version != ARCHIVE_VERSION)
+        return fail("unsupported version " + Convert::to_str(header.version));
+    if (header.index_offset > size ||
+        header.entry_count > (size - header.index_offset) / sizeof(ArchiveEntry))
+        return fail("truncated index");
+
+    index.reserve(static_cast<size_t>(header.entry_count));
+    for (std::uint64_t i = 0u; i < header.entry_count; ++i)
+    {
+        ArchiveEntry entry;
+        std::memcpy(&entry, data + header.index_offset + i * sizeof(ArchiveEntry), sizeof(entry));
+
+        if (entry.path_offset > size || entry.path_length > size - entry.path_offset ||
+            entry.data_offset > size || entry.data_size   > size - entry.data_offset)
+            return fail("corrupted entry");
+
+        const std::string_view entry_path{ reinterpret_cast<const char*>(data + entry.path_offset),
+                                           static_cast<size_t>(entry.path_length) };
+        index.emplace(entry_path, ArchivedFile{ data + entry.data_offset,
+                                                static_cast<size_t>(entry.data_size) });
+    }
+
+    LOG_INTEL("archive mounted (" + Convert::to_str(index.size()) + " files): " + path);
+    return true;
+}
+
+bool Archive::is_mounted() const
+{
+    return data != nullptr;
+}
+
+const ArchivedFile* Archive::find(const std::string& path) const
+{
+    if (index.empty())
+        return nullptr;
+
+    // Most paths need no normalizing, which would cost a few allocations per lookup:
+    const auto it = is_archive_key(path) ? index.find(path) : index.find(get_archive_key(path));
+    return it != index.end() ? &it->second : nullptr;
+}
+
+std::vector<std::string_view> Archive::get_paths() const
+{
+    std::vector<std::string_view> paths;
+    paths.reserve(index.size());
+    for (const auto& [path, file] : index)
+        paths.push_back(path);
+    return paths;
+}
+
+void Archive::unmount()
+{
+    index.clear();
+
+    if (data)
+        unmap_file(data, size);
+
+    data = nullptr;
+    size = 0u;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool exists_in_archive_or_drive(const std::string& path)
+{
+    if (Archive::instance().find(path))
+        return true;
+
+    std::error_code error;
+    return fs::exists(path, error);
+}
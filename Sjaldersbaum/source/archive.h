@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Packed archives bundle the files under resources/ into one file (see tools/packer.cpp).
+// Layout: ArchiveHeader | file contents | ArchiveEntry[entry_count] | paths
+// All offsets are absolute; paths are decapitalized and relative to the game's directory.
+
+constexpr char          ARCHIVE_MAGIC[4] = { 'S', 'J', 'P', 'K' };
+constexpr std::uint32_t ARCHIVE_VERSION  = 1u;
+
+struct ArchiveHeader
+{
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t entry_count;
+    std::uint64_t index_offset;
+};
+
+struct ArchiveEntry
+{
+    std::uint64_t path_offset;
+    std::uint64_t path_length;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct ArchivedFile
+{
+    const void* data;
+    std::size_t size;
+};
+
+// Singleton for reading resources from a memory-mapped archive, instead of opening loose files.
+// The archive stays mapped until the app closes, so resources may keep referring to its memory
+// (e.g. fonts and music, which SFML reads from on demand).
+class Archive
+{
+public:
+    static Archive& instance();
+
+    // Maps the archive at path. Returns false if there is none, or if it is invalid;
+    // resources are then simply loaded from the drive.
+    bool mount(const std::string& path);
+
+    bool is_mounted() const;
+
+    // Returns the archived file at path (case-insensitive), or nullptr if it is not archived.
+    const ArchivedFile* find(const std::string& path) const;
+
+    // Returns the paths of all archived files; decapitalized and with forward slashes.
+    std::vector<std::string_view> get_paths() const;
+
+private:
+    void unmount();
+
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+
+    std::unordered_map<std::string_view, ArchivedFile> index; // Keys point into the mapped data.
+
+private:
+    Archive();
+    ~Archive();
+    Archive(const Archive&) = delete;
+    Archive(Archive&&) = delete;
+    Archive& operator=(const Archive&) = delete;
+    Archive& operator=(Archive&&) = delete;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Loads resource (sf::Image, sf::Font, sf::SoundBuffer, ...) from the archive if it contains path,
+// otherwise from the drive.
+template<typename T>
+bool load_from_archive_or_drive(T& resource, const std::string& path);
+
+// Like load_from_archive_or_drive, but for streamed resources (sf::Music, sf::InputSoundFile).
+template<typename T>
+bool open_from_archive_or_drive(T& resource, const std::string& path);
+
+// Returns true if the file at path is archived or exists on the drive.
+bool exists_in_archive_or_drive(const std::string& path);
+
+/*------------------------------------------------------------------------------------------------*/
+// Implementation:
+
+template<typename T>
+inline bool load_from_archive_or_drive(T& resource, const std::string& path)
+{
+    if (const ArchivedFile* file = Archive::instance().find(path))
+        return resource.loadFromMemory(file->data, file->size);
+
+    return resource.loadFromFile(path);
+}
+
+template<typename T>
+inline bool open_from_archive_or_drive(T& resource, const std::string& path)
+{
+    if (const ArchivedFile* file = Archive::instance().find(path))
+        return resource.openFromMemory(file->data, file->size);
+
+    return resource.openFromFile(path);
+}
@@ -1,6 +1,11 @@
 #include "audio.h"
 
 #include <filesystem>
+#include <unordered_set>
+
+#include "archive.h"
+#include "thread_pool.h"
+#include "mixing_bus.h"
 
 namespace fs = std::filesystem;
 
@@ -49,6 +54,18 @@ void load_global_sounds()
     GlobalSounds::POSITIVE              = AudioPlayer::instance().load(POSITIVE_PATH,               true);
     GlobalSounds::NEGATIVE              = AudioPlayer::instance().load(NEGATIVE_PATH,               true);
     GlobalSounds::NEUTRAL               = AudioPlayer::instance().load(NEUTRAL_PATH,                true);
+
+    // Frequent, ambient sounds yield to the ones responding to the player:
+    auto& audio_player = AudioPlayer::instance();
+    audio_player.set_voice_policy(GlobalSounds::GENERIC_HOVER,  SoundPriority::Low,    2);
+    audio_player.set_voice_policy(GlobalSounds::TYPEWRITER,     SoundPriority::Low,    3);
+    audio_player.set_voice_policy(GlobalSounds::PAPER_PICKUPS,  SoundPriority::Normal, 2);
+    audio_player.set_voice_policy(GlobalSounds::PAPER_RELEASE,  SoundPriority::Normal, 2);
+    audio_player.set_voice_policy(GlobalSounds::LIGHT_ON,       SoundPriority::High,   1);
+    audio_player.set_voice_policy(GlobalSounds::LIGHT_OFF,      SoundPriority::High,   1);
+    audio_player.set_voice_policy(GlobalSounds::POSITIVE,       SoundPriority::High,   1);
+    audio_player.set_voice_policy(GlobalSounds::NEGATIVE,       SoundPriority::High,   1);
+    audio_player.set_voice_policy(GlobalSounds::NEUTRAL,        SoundPriority::High,   1);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -58,50 +75,120 @@ constexpr Seconds VOLUME_PROGRESSION_DURATION = 0.4f;
 
 constexpr Seconds SOUND_COOLDOWN = 0.07f;
 
+constexpr int DEFAULT_VOICE_LIMIT = 32;
+constexpr int MAX_VOICE_LIMIT     = 128; // OpenAL implementations typically provide 256 sources.
+constexpr int DEFAULT_MAX_VOICES_PER_SOUND = 4;
+
+// Scanned for sound variants at startup; see SoundVariantManifest.
+const std::string SOUNDS_DIRECTORY = "resources/audio/sounds";
+
 bool exists(std::string path)
 {
     if (!consists_of_systemic_characters(path))
         return false;
-    return fs::exists(path);
+    return exists_in_archive_or_drive(path);
 }
 
 /*------------------------------------------------------------------------------------------------*/
 
-SoundBufferWrapper::SoundBufferWrapper(const std::string& path) :
-    global{ false },
-    playing{ false },
-    previous_rand_index{ 0u }
+// Variants are stored decapitalized, with forward slashes and without "./" or "..".
+std::string get_variant_key(const std::string& path)
+{
+    return get_decapitalized(fs::path{ path }.lexically_normal().generic_string());
+}
+
+// Returns path with its (trailing) variant index replaced; e.g. "a_0.ogg" -> "a_2.ogg".
+std::string get_variant_path(const std::string& path, const size_t index)
 {
-    std::string alt_path = path.substr(0u, path.rfind('.'));
-    std::string extension = path.substr(path.rfind('.'), std::string::npos);
+    const size_t extension_start = path.rfind('.');
+    const size_t index_start     = path.rfind('_', extension_start) + 1u;
+    return path.substr(0u, index_start) + Convert::to_str(index) + path.substr(extension_start);
+}
+
+bool is_first_variant(const std::string& path)
+{
+    const size_t extension_start = path.rfind('.');
+    return extension_start != std::string::npos && extension_start >= 2u &&
+           path.compare(extension_start - 2u, 2u, "_0") == 0;
+}
+
+void SoundVariantManifest::build(const std::string& directory)
+{
+    std::unordered_set<std::string> keys;
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it{ directory, error }, end; !error && it != end; it.increment(error))
+        if (it->is_regular_file(error))
+            keys.insert(get_variant_key(it->path().string()));
+
+    for (const auto path : Archive::instance().get_paths())
+        keys.emplace(path);
 
-    if (!ends_with(alt_path, "_0")) // SoundBuffer has no alternatives.
+    for (const auto& key : keys)
     {
-        buffers.emplace_back(SoundBufferReference());
-        buffers.back().load(path);
-        return;
+        if (!is_first_variant(key))
+            continue;
+
+        size_t count = 1u;
+        while (contains(keys, get_variant_path(key, count)))
+            ++count;
+        variant_counts.emplace(key, count);
     }
 
-    size_t i = 0u;
-    while (true)
-    {
-        buffers.emplace_back(SoundBufferReference());
-        buffers.back().load(alt_path + extension);
+    if (RESOURCE_LOGGING)
+        LOG_DEBUG("sound variant groups found: " + Convert::to_str(variant_counts.size()));
+}
 
-        alt_path.replace(alt_path.rfind('_') + 1u, std::string::npos, Convert::to_str(++i));
-        if (!exists(alt_path + extension))
-        {
-            if (RESOURCE_LOGGING)
-                LOG_INTEL("sound file not found; assuming end at: " + alt_path);
-            break;
-        }
+std::vector<std::string> SoundVariantManifest::get_variant_paths(const std::string& path)
+{
+    if (!is_first_variant(path))
+        return { path };
+
+    const std::string key = get_variant_key(path);
+    auto it = variant_counts.find(key);
+    if (it == variant_counts.end())
+    {
+        size_t count = 1u;
+        while (exists(get_variant_path(path, count)))
+            ++count;
+
+        if (RESOURCE_LOGGING)
+            LOG_DEBUG("sound variants found outside of " + SOUNDS_DIRECTORY + ": " +
+                      Convert::to_str(count) + " for " + path);
+        it = variant_counts.emplace(key, count).first;
     }
+
+    std::vector<std::string> paths;
+    paths.reserve(it->second);
+    for (size_t i = 0u; i < it->second; ++i)
+        paths.push_back(get_variant_path(path, i));
+    return paths;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+SoundBufferWrapper::SoundBufferWrapper(const std::vector<std::string>& paths) :
+    global{ false },
+    playing{ false },
+    priority{ SoundPriority::Normal },
+    max_voices{ DEFAULT_MAX_VOICES_PER_SOUND },
+    last_play_time{ -SOUND_COOLDOWN },
+    previous_rand_index{ 0u }
+{
+    buffers.resize(paths.size());
+    for (size_t i = 0u; i < paths.size(); ++i)
+        buffers[i].load(paths[i]);
 }
 
 const sf::SoundBuffer& SoundBufferWrapper::get() const
+{
+    return get_reference().get();
+}
+
+const SoundBufferReference& SoundBufferWrapper::get_reference() const
 {
     if (buffers.size() == 1u)
-        return buffers.front().get();
+        return buffers.front();
     else
     {
         size_t rand_index = rand11(size_t(0), buffers.size());
@@ -109,54 +196,139 @@ const sf::SoundBuffer& SoundBufferWrapper::get() const
             rand_index = rand11(size_t(0), buffers.size());
         previous_rand_index = rand_index;
 
-        auto it = buffers.begin();
-        std::advance(it, rand_index);
-        return it->get();
+        return buffers[rand_index];
     }
 }
 
 /*------------------------------------------------------------------------------------------------*/
 
+Voice::Voice() :
+    loudness{ 0.f },
+    id{ 0u },
+    priority{ SoundPriority::Low },
+    start_time{ 0.f }
+{
+
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+PendingMusic::PendingMusic(const std::string& path) :
+    path{ path },
+    music{ std::make_unique<sf::Music>() }
+{
+    // The worker only borrows the music; it is destructed on the main thread, once opened.
+    opened = ThreadPool::instance().submit([music = music.get(), path]()
+    {
+        return open_from_archive_or_drive(*music, path);
+    });
+}
+
+bool PendingMusic::is_ready() const
+{
+    return opened.valid() && opened.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready;
+}
+
+void PendingMusic::wait() const
+{
+    if (opened.valid())
+        opened.wait();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 AudioPlayer::AudioPlayer() : 
+    audio_time{ 0.f },
     playlist_shuffle{ false },
     playlist_loudness{ 0.f },
     playlist_interval{ 0.f },
     playlist_interval_timer{ 0.f },
     playlist_index{ 0u },
+    playlist_track_due{ false },
+    current_track{ std::make_unique<sf::Music>() },
+    next_track_index{ 0u },
     volume{ 0.f },
     fade_multiplier{ 0.f },
     force_sounds_fade{ false }
 {
     volume.set_progression_duration(VOLUME_PROGRESSION_DURATION);
+    voices.resize(DEFAULT_VOICE_LIMIT);
+    variant_manifest.build(SOUNDS_DIRECTORY);
+}
+
+AudioPlayer::~AudioPlayer()
+{
+    // Workers may still be opening music that is about to be destructed:
+    next_track.wait();
+    for (const auto& [pending_stream, loudness] : pending_streams)
+        pending_stream.wait();
+    for (const auto& pending_music : discarded_music)
+        pending_music.wait();
 }
 
 void AudioPlayer::update(const Seconds elapsed_time)
 {
+    audio_time += elapsed_time;
+
+    if (mixing_bus)
+        mixing_bus->update();
+
+    // Buffers of sounds that have ended may be destructed by the ResourceManager from now on:
+    for (auto& voice : voices)
+        if (voice.buffer.is_loaded() && voice.sound.getStatus() == sf::Sound::Status::Stopped)
+            voice.buffer = SoundBufferReference{};
+
     volume.update(elapsed_time);
     fade_multiplier.update(elapsed_time);
 
     if (volume.has_changed_since_last_check() || fade_multiplier.has_changed_since_last_check())
     {
-        for (auto& [sound, loudness] : sounds)
+        for (auto& voice : voices)
         {
             if (force_sounds_fade)
-                sound.setVolume(volume.get_current() * fade_multiplier.get_current() * loudness);
+                voice.sound.setVolume(volume.get_current() * fade_multiplier.get_current() *
+                                      voice.loudness);
             else
-                sound.setVolume(volume.get_current() * loudness);
+                voice.sound.setVolume(volume.get_current() * voice.loudness);
         }
 
-        current_track.setVolume(volume.get_current() * fade_multiplier.get_current() *
-                                playlist_loudness);
+        if (mixing_bus)
+            mixing_bus->set_gain(volume.get_current() / 100.f *
+                                 (force_sounds_fade ? fade_multiplier.get_current() : 1.f));
+
+        current_track->setVolume(volume.get_current() * fade_multiplier.get_current() *
+                                 playlist_loudness);
     }
 
-    for (auto it = sounds.begin(); it != sounds.end();)
+    // Streams start playing as soon as they have been opened:
+    for (auto it = pending_streams.begin(); it != pending_streams.end();)
     {
-        if (it->first.getStatus() != sf::Sound::Status::Playing)
-            it = sounds.erase(it);
-        else
+        auto& [pending_stream, loudness] = *it;
+        if (!pending_stream.is_ready())
+        {
             ++it;
+            continue;
+        }
+
+        if (pending_stream.opened.get())
+        {
+            pending_stream.music->setVolume(volume.get_current() * fade_multiplier.get_current() *
+                                            loudness);
+            pending_stream.music->play();
+            streams.emplace(pending_stream.path,
+                            std::make_pair(std::move(pending_stream.music),
+                                           ProgressiveFloat(loudness, VOLUME_PROGRESSION_DURATION)));
+        }
+        else
+            LOG_ALERT("could not stream from:\n" + pending_stream.path);
+
+        it = pending_streams.erase(it);
     }
 
+    discarded_music.erase(std::remove_if(discarded_music.begin(), discarded_music.end(),
+                                         [](const PendingMusic& music) { return music.is_ready(); }),
+                          discarded_music.end());
+
     for (auto it = streams.begin(); it != streams.end();)
     {
         auto& local_volume_multiplier = it->second.second;
@@ -175,15 +347,7 @@ void AudioPlayer::update(const Seconds elapsed_time)
                          local_volume_multiplier.get_current());
     }
 
-    for (auto it = cooldowns.begin(); it != cooldowns.end();)
-    {
-        if ((it->second -= elapsed_time) <= 0.f)
-            it = cooldowns.erase(it);
-        else
-            ++it;
-    }
-
-    if (!playlist.empty() && current_track.getStatus() == sf::Sound::Stopped)
+    if (!playlist.empty() && !playlist_track_due && current_track->getStatus() == sf::Sound::Stopped)
     {
         // Music just stopped; start the interval:
         if (playlist_interval_timer <= 0.f)
@@ -196,24 +360,26 @@ void AudioPlayer::update(const Seconds elapsed_time)
 
         // Interval has ended:
         if ((playlist_interval_timer -= elapsed_time) <= 0.f)
+            playlist_track_due = true;
+    }
+
+    // The next track has been opened while the previous one played, so it starts right away:
+    if (playlist_track_due && next_track.is_ready())
+    {
+        playlist_track_due = false;
+        playlist_index = next_track_index;
+
+        if (next_track.opened.get())
         {
-            if (playlist.size() != 1u)
-            {
-                if (playlist_shuffle)
-                {
-                    const size_t old_playlist_index = playlist_index;
-                    while (old_playlist_index == playlist_index)
-                        playlist_index = rand(size_t(0), playlist.size());
-                }
-                else
-                    if (++playlist_index == playlist.size())
-                        playlist_index = 0u;
-            }
-
-            if (!current_track.openFromFile(playlist[playlist_index]))
-                LOG_ALERT("could not play track from:\n" + playlist[playlist_index]);
-            current_track.play();
+            current_track = std::move(next_track.music);
+            current_track->setVolume(volume.get_current() * fade_multiplier.get_current() *
+                                     playlist_loudness);
+            current_track->play();
         }
+        else
+            LOG_ALERT("could not play track from:\n" + next_track.path);
+
+        prefetch_next_track();
     }
 }
 
@@ -229,7 +395,7 @@ SoundID AudioPlayer::load(const std::string& path, const bool global)
 
     const SoundID id = get_id(path);
     if (!contains(buffers, id))
-        buffers.emplace(id, std::make_pair(SoundBufferWrapper(path), global));
+        buffers.emplace(id, std::make_pair(SoundBufferWrapper(variant_manifest.get_variant_paths(path)), global));
     return id;
 }
 
@@ -249,29 +415,128 @@ void AudioPlayer::play(const SoundID id, float loudness)
     if (!assure_bounds(loudness, 0.f, 1.f))
         LOG_ALERT("invalid loudness had to be adjusted; [0-1]");
 
-    if (contains(cooldowns, id))
+    SoundBufferWrapper& wrapper = buffers.at(id).first;
+    if (audio_time - wrapper.last_play_time < SOUND_COOLDOWN)
         return;
-    cooldowns.emplace(id, SOUND_COOLDOWN);
 
-    sounds.emplace_back(std::make_pair(sf::Sound{ buffers.at(id).first.get() }, loudness));
-    sounds.back().first.setVolume(volume.get_current() * fade_multiplier.get_current() * loudness);
-    sounds.back().first.play();
+    if (mixing_bus)
+    {
+        wrapper.last_play_time = audio_time;
+        mixing_bus->mix(wrapper.get_reference(), loudness, id, wrapper.priority, wrapper.max_voices);
+        return;
+    }
+
+    Voice* voice = acquire_voice(id, wrapper.priority, wrapper.max_voices);
+    if (!voice)
+        return;
+
+    wrapper.last_play_time = audio_time;
+
+    voice->loudness   = loudness;
+    voice->id         = id;
+    voice->priority   = wrapper.priority;
+    voice->start_time = audio_time;
+
+    // Stops whatever the voice was playing:
+    voice->buffer = wrapper.get_reference();
+    voice->sound.setBuffer(voice->buffer.get());
+    voice->sound.setVolume(volume.get_current() * fade_multiplier.get_current() * loudness);
+    voice->sound.play();
 }
 
-void AudioPlayer::stream(const std::string& path, float loudness)
+void AudioPlayer::set_voice_policy(const SoundID id, const SoundPriority priority, int max_voices)
 {
-    auto stream = std::make_unique<sf::Music>();
-    if (!stream->openFromFile(path))
+    if (!contains(buffers, id))
     {
-        LOG_ALERT("could not stream from:\n" + path);
+        LOG_ALERT("unknown id: " + Convert::to_str(id));
+        return;
+    }
+    if (!assure_bounds(max_voices, 1, MAX_VOICE_LIMIT))
+        LOG_ALERT("invalid max_voices had to be adjusted; [1-" + Convert::to_str(MAX_VOICE_LIMIT) + ']');
+
+    SoundBufferWrapper& wrapper = buffers.at(id).first;
+    wrapper.priority   = priority;
+    wrapper.max_voices = max_voices;
+}
+
+void AudioPlayer::set_voice_limit(int voice_limit)
+{
+    if (!assure_bounds(voice_limit, 1, MAX_VOICE_LIMIT))
+        LOG_ALERT("invalid voice limit had to be adjusted; [1-" + Convert::to_str(MAX_VOICE_LIMIT) + ']');
+
+    // Sounds on removed voices are cut off:
+    voices.resize(static_cast<size_t>(voice_limit));
+}
+
+void AudioPlayer::set_software_mixing(const bool enable)
+{
+    if (enable == static_cast<bool>(mixing_bus))
         return;
+
+    if (enable)
+    {
+        mixing_bus = std::make_unique<MixingBus>();
+        mixing_bus->set_gain(volume.get_current() / 100.f *
+                             (force_sounds_fade ? fade_multiplier.get_current() : 1.f));
+        mixing_bus->play();
+    }
+    else
+        mixing_bus.reset();
+}
+
+void AudioPlayer::stop_mixed_sounds(const std::string& path)
+{
+    if (mixing_bus)
+        mixing_bus->stop_sounds(path);
+}
+
+Voice* AudioPlayer::acquire_voice(const SoundID id, const SoundPriority priority, const int max_voices)
+{
+    Voice* free_voice      = nullptr;
+    Voice* oldest_instance = nullptr; // Oldest voice playing the same sound.
+    Voice* weakest_voice   = nullptr; // Oldest voice of the lowest priority.
+    int instance_count = 0;
+
+    for (auto& voice : voices)
+    {
+        if (voice.sound.getStatus() != sf::Sound::Status::Playing)
+        {
+            if (!free_voice)
+                free_voice = &voice;
+            continue;
+        }
+
+        if (voice.id == id)
+        {
+            ++instance_count;
+            if (!oldest_instance || voice.start_time < oldest_instance->start_time)
+                oldest_instance = &voice;
+        }
+
+        if (!weakest_voice || voice.priority < weakest_voice->priority ||
+            (voice.priority == weakest_voice->priority && voice.start_time < weakest_voice->start_time))
+            weakest_voice = &voice;
     }
+
+    if (instance_count >= max_voices)
+        return oldest_instance;
+
+    if (free_voice)
+        return free_voice;
+
+    if (weakest_voice && weakest_voice->priority <= priority)
+        return weakest_voice;
+
+    return nullptr;
+}
+
+void AudioPlayer::stream(const std::string& path, float loudness)
+{
     if (!assure_bounds(loudness, 0.f, 1.f))
         LOG_ALERT("invalid loudness had to be adjusted; [0-1]");
-    stream->setVolume(volume.get_current() * fade_multiplier.get_current() * loudness);
-    stream->play();
-    streams.emplace(path, std::make_pair(std::move(stream),
-                                         ProgressiveFloat(loudness, VOLUME_PROGRESSION_DURATION)));
+
+    // Started in update(), once opened:
+    pending_streams.emplace_back(PendingMusic{ path }, loudness);
 }
 
 void AudioPlayer::stop(const std::string& path)
@@ -279,15 +544,30 @@ void AudioPlayer::stop(const std::string& path)
     for (auto& [m_path, stream_volume_pair] : streams)
         if (m_path == path)
             stream_volume_pair.second.set_target(0.f);
+
+    for (auto it = pending_streams.begin(); it != pending_streams.end();)
+    {
+        if (it->first.path == path)
+        {
+            discard(it->first);
+            it = pending_streams.erase(it);
+        }
+        else
+            ++it;
+    }
 }
 
 void AudioPlayer::stop_and_unload_all()
 {
     streams.clear();
 
+    for (auto& [pending_stream, loudness] : pending_streams)
+        discard(pending_stream);
+    pending_streams.clear();
+
     // Sounds are not stoppable. They go on until the end because they're expected to be short anyways.
-    // Even though their wrappers are erased here, the actual destruction of buffers occurs after a
-    // lenghty delay, so this should be fine as long as sounds are short (less than a minute).
+    // Even though their wrappers are erased here, voices (and mixing slots) that still play them
+    // keep their buffers referenced, so the ResourceManager cannot destruct them until they end.
 
     for (auto it = buffers.begin(); it != buffers.end();)
     {
@@ -301,7 +581,9 @@ void AudioPlayer::stop_and_unload_all()
 void AudioPlayer::set_playlist(const std::vector<std::string>& playlist,
                                const bool shuffle, const Seconds interval, float loudness)
 {
-    current_track.stop();
+    current_track->stop();
+    playlist_track_due = false;
+    discard(next_track);
 
     this->playlist = playlist;
     playlist_index = playlist.size() - 1u;
@@ -311,8 +593,38 @@ void AudioPlayer::set_playlist(const std::vector<std::string>& playlist,
     if (!assure_bounds(loudness, 0.f, 1.f))
         LOG_ALERT("invalid loudness had to be adjusted; [0-1]");
     playlist_loudness = loudness;
-    current_track.setVolume(volume.get_current() *
-                            this->fade_multiplier.get_current() * playlist_loudness);
+    current_track->setVolume(volume.get_current() *
+                             this->fade_multiplier.get_current() * playlist_loudness);
+
+    if (!this->playlist.empty())
+        prefetch_next_track();
+}
+
+void AudioPlayer::prefetch_next_track()
+{
+    next_track_index = playlist_index;
+    if (playlist.size() != 1u)
+    {
+        if (playlist_shuffle)
+        {
+            while (next_track_index == playlist_index)
+                next_track_index = rand(size_t(0), playlist.size());
+        }
+        else
+            if (++next_track_index == playlist.size())
+                next_track_index = 0u;
+    }
+
+    discard(next_track);
+    next_track = PendingMusic{ playlist[next_track_index] };
+}
+
+void AudioPlayer::discard(PendingMusic& pending_music)
+{
+    if (pending_music.opened.valid() && !pending_music.is_ready())
+        discarded_music.push_back(std::move(pending_music));
+
+    pending_music = PendingMusic{};
 }
 
 void AudioPlayer::set_volume(const int volume)
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <list>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <future>
 #include <SFML/Audio.hpp>
 
 #include "progressive.h"
@@ -34,25 +37,89 @@ void load_global_sounds();
 
 /*------------------------------------------------------------------------------------------------*/
 
+// Decides which sounds are cut off when all voices are busy; see AudioPlayer::play().
+enum class SoundPriority
+{
+    Low,    // e.g. hovering, typing
+    Normal,
+    High    // e.g. feedback to the player's actions
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Implementation detail for AudioPlayer.
+// Knows which variants of each sound exist, so that they are resolved without querying the drive.
+// The presence of variants is indicated by a trailing "_0" in a path; in that case, it is assumed
+// that similar paths, ending with "_1", "_2", etc, may exist.
+class SoundVariantManifest
+{
+public:
+    // Finds the variants within directory (recursively) and within the archive; call once.
+    void build(const std::string& directory);
+
+    // Returns the paths of all variants of path; or just path, if it has none.
+    // Variants of sounds outside the built directory are looked up on the drive once, then remembered.
+    std::vector<std::string> get_variant_paths(const std::string& path);
+
+private:
+    std::unordered_map<std::string, size_t> variant_counts; // Key of "_0" path -> count.
+};
+
 // Implementation detail for AudioPlayer.
 struct SoundBufferWrapper
 {
-    // Wraps one or several SoundBufferReferences.
-    // The presence of several SoundBuffers can be indicated by a trailing "_0" in path.
-    // In that case, it is assumed that similar paths, ending with "_1", "_2", etc, may exist.
-    SoundBufferWrapper(const std::string& path);
+    // Wraps one or several SoundBufferReferences; i.e. the variants of a sound.
+    SoundBufferWrapper(const std::vector<std::string>& paths);
 
     // Note that if several SoundBuffers are wrapped, then only one will be returned at random.
     const sf::SoundBuffer& get() const;
+    const SoundBufferReference& get_reference() const;
     
     bool global;
     bool playing;
 
+    SoundPriority priority;
+    int max_voices;          // How many instances of this sound may play at once.
+    Seconds last_play_time;  // Same sound can't be played too rapidly.
+
 private:
-    std::list<SoundBufferReference> buffers;
+    std::vector<SoundBufferReference> buffers;
     mutable size_t previous_rand_index;
 };
 
+// Implementation detail for AudioPlayer. A preallocated sf::Sound (OpenAL source) that is reused.
+struct Voice
+{
+    Voice();
+
+    SoundBufferReference buffer; // Keeps the samples alive while playing; released once stopped.
+    sf::Sound sound;
+    float loudness;
+    SoundID id;
+    SoundPriority priority;
+    Seconds start_time;
+};
+
+// Implementation detail for AudioPlayer. Music whose file is opened on a worker thread,
+// so that opening it (reading headers, setting up the decoder) never stalls a frame.
+struct PendingMusic
+{
+    PendingMusic() = default;
+    PendingMusic(const std::string& path);
+
+    // Returns true once opening is done, whether it succeeded or not.
+    bool is_ready() const;
+
+    // Blocks until opening is done (if it was started at all).
+    void wait() const;
+
+    std::string path;
+    std::unique_ptr<sf::Music> music;
+    std::future<bool> opened;
+};
+
+class MixingBus;
+
 /*------------------------------------------------------------------------------------------------*/
 
 // Loads Sounds from specified paths, maps them to unique identifiers, and allows them to be
@@ -74,20 +141,39 @@ public:
     // Note that an empty path returns 0. Playing 0 plays nothing and logs no errors.
     SoundID load(const std::string& path, bool global);
 
-    // Plays a short sound through a SoundBuffer(Wrapper).
+    // Plays a short sound through a SoundBuffer(Wrapper) on one of the voices.
+    // If the sound already plays on its maximum number of voices, its oldest instance is restarted.
+    // If all voices are busy, the oldest sound of the lowest priority (but no higher than this
+    // sound's) is cut off; otherwise, the sound is not played.
     // Note that sounds are not affected by the fade effect and continue playing after leaving a level.
     void play(SoundID id, float loudness = 1.f);
 
+    // Sets how the sounds of id compete for voices (SoundPriority::Normal and 4 voices by default).
+    void set_voice_policy(SoundID id, SoundPriority priority, int max_voices);
+
+    // Sets the number of voices, i.e. how many sounds can play at once (OpenAL sources are limited).
+    void set_voice_limit(int voice_limit);
+
+    // If enabled, sounds are mixed in software into a single stream instead (see MixingBus);
+    // the same voice policies apply, but overlapping sounds no longer cost OpenAL sources.
+    void set_software_mixing(bool enable);
+
+    // Stops the sounds that are mixed in software from the SoundBuffer at path (all if empty).
+    // Has to precede reloading SoundBuffers in place; unlike voices, the mix is not detached.
+    void stop_mixed_sounds(const std::string& path = "");
+
     // Streams from a file. Streaming is cancelled upon leaving a level.
+    // The file is opened in the background; the stream starts playing once that is done.
     void stream(const std::string& path, float loudness = 1.f);
     void stop(const std::string& path);
 
     // Note that this will not unload global sounds.
-    // Also, SoundBuffers are stored by the ResourceManager, so their actual destruction will be delayed.
+    // Sounds that are still playing keep their SoundBuffers referenced until they end.
     void stop_and_unload_all();
 
     // If shuffle is enabled, the music is played with random order and intervals in range: [interval / 2, interval].
     // Otherwise, the music is played with default order and fixed intervals.
+    // The next track is always opened in advance, while the current one plays.
     void set_playlist(const std::vector<std::string>& playlist,
                       bool shuffle, Seconds interval, float loudness);
 
@@ -98,13 +184,27 @@ public:
     void fade_out(const Seconds progression_duration, bool force_sounds_fade = false);
     void fade_in(const Seconds progression_duration);
 
+private:
+    // Returns a voice for a sound of id to be played on, or nullptr if there should be none.
+    Voice* acquire_voice(SoundID id, SoundPriority priority, int max_voices);
+
+    // Picks the track to follow the current one and starts opening it.
+    void prefetch_next_track();
+
+    // Music that is still being opened is kept until its worker is done with it.
+    void discard(PendingMusic& pending_music);
+
 private:
     std::unordered_map<SoundID, std::pair<SoundBufferWrapper, bool>> buffers; // bool -> globality
-    std::list<std::pair<sf::Sound, float>> sounds;
-    std::unordered_map<SoundID, Seconds> cooldowns; // Same sound can't be played too rapidly.
+    SoundVariantManifest variant_manifest;
+    std::vector<Voice> voices;
+    std::unique_ptr<MixingBus> mixing_bus; // nullptr unless software mixing is enabled.
+    Seconds audio_time; // Time since start; for cooldowns and the age of voices.
 
     // Streams are loaded from file and can be stopped manually (via fading them out, represented by the ProgressiveFloat).
     std::unordered_multimap<std::string, std::pair<std::unique_ptr<sf::Music>, ProgressiveFloat>> streams;
+    std::vector<std::pair<PendingMusic, float>> pending_streams; // float -> loudness
+    std::vector<PendingMusic> discarded_music;
 
     std::vector<std::string> playlist;
     bool    playlist_shuffle;
@@ -112,7 +212,10 @@ private:
     Seconds playlist_interval;
     Seconds playlist_interval_timer;
     size_t  playlist_index;
-    sf::Music current_track;
+    bool    playlist_track_due; // The interval has ended, but the next track may not be open yet.
+    std::unique_ptr<sf::Music> current_track;
+    PendingMusic next_track;
+    size_t       next_track_index;
 
     ProgressiveFloat volume;
     ProgressiveFloat fade_multiplier;
@@ -120,6 +223,7 @@ private:
 
 private:
     AudioPlayer();
+    ~AudioPlayer();
     AudioPlayer(const AudioPlayer&) = delete;
     AudioPlayer(AudioPlayer&&) = delete;
     AudioPlayer& operator=(const AudioPlayer&) = delete;
@@ -127,7 +127,8 @@ void Camera::set_resolution(const PxVec2 resolution)
     apply_zoom();
 }
 
-void Camera::set_zoom_progressively(const Zoom option, Seconds progression_duration)
+void Camera::set_zoom_progressively(const Zoom option, Seconds progression_duration,
+                                    const Easing easing)
 {
     if (!assure_bounds(progression_duration, 0.f, 60.f))
         LOG_ALERT("invalid progression_duration had to be adjusted; [0-60]");
@@ -137,10 +138,12 @@ void Camera::set_zoom_progressively(const Zoom option, Seconds progression_durat
         return;
 
     zoom.set_progression_duration(progression_duration);
+    zoom.set_easing(easing);
     zoom.set_target(new_zoom);
 }
 
-void Camera::set_center_progressively(PxVec2 target_center, Seconds progression_duration)
+void Camera::set_center_progressively(PxVec2 target_center, Seconds progression_duration,
+                                      const Easing easing)
 {
     if (!assure_bounds(progression_duration, 0.f, 60.f))
         LOG_ALERT("invalid progression_duration had to be adjusted; [0-60]");
@@ -149,6 +152,7 @@ void Camera::set_center_progressively(PxVec2 target_center, Seconds progression_
 
     assure_is_contained_by(target_center, central_bounds);
     center.set_progression_duration(progression_duration);
+    center.set_easing(easing);
     center.set_target(target_center);
 }
 
@@ -157,6 +161,20 @@ const sf::View& Camera::get_view() const
     return view;
 }
 
+void Camera::save_interpolation_state()
+{
+    previous_view_center = view.getCenter();
+    previous_view_size   = view.getSize();
+}
+
+sf::View Camera::get_interpolated_view(const float interpolation) const
+{
+    sf::View interpolated_view = view;
+    interpolated_view.setCenter(round_hu(blend(previous_view_center, view.getCenter(), interpolation)));
+    interpolated_view.setSize(blend(previous_view_size, view.getSize(), interpolation));
+    return interpolated_view;
+}
+
 PxVec2 Camera::get_center() const
 {
     return view.getCenter();
@@ -182,6 +200,11 @@ bool Camera::is_zoomed_by_mouse() const
     return zoomed_by_mouse;
 }
 
+bool Camera::is_idle() const
+{
+    return !center.is_progressing() && !zoom.is_progressing() && velocities == PxVec2{ 0.f, 0.f };
+}
+
 void Camera::render_debug_stats(sf::RenderTarget& target) const
 {
     if (debug_mode)
@@ -27,11 +27,20 @@ public:
     void set_resolution(PxVec2 resolution);
 
     enum class Zoom { In, Out };
-    void set_zoom_progressively(Zoom option, Seconds progression_duration);
-    void set_center_progressively(PxVec2 target_center, Seconds progression_duration);
+    void set_zoom_progressively(Zoom option, Seconds progression_duration,
+                                Easing easing = Easing::Linear);
+    void set_center_progressively(PxVec2 target_center, Seconds progression_duration,
+                                  Easing easing = Easing::Linear);
 
     const sf::View& get_view() const;
 
+    // Records the view as it is before a simulation step; see get_interpolated_view().
+    void save_interpolation_state();
+
+    // Returns the view between its state before the latest step (0) and its current state (1);
+    // for rendering between simulation steps.
+    sf::View get_interpolated_view(float interpolation) const;
+
     PxVec2 get_center() const;
 
     bool is_moved_by_keyboard() const;
@@ -40,6 +49,9 @@ public:
     bool is_zoomed_by_keyboard() const;
     bool is_zoomed_by_mouse() const;
 
+    // Returns true if the view is neither moving nor zooming.
+    bool is_idle() const;
+
     void render_debug_stats(sf::RenderTarget& target) const;
 
     void initialize_debug_components();
@@ -73,6 +85,8 @@ private:
 
 private:
     sf::View view;
+    PxVec2 previous_view_center;
+    PxVec2 previous_view_size;
 
     PxVec2 resolution;
     PxRect central_bounds;
@@ -11,6 +11,14 @@
 
 /*------------------------------------------------------------------------------------------------*/
 
+const std::unordered_map<std::string, LogLevel> KNOWN_LOG_LEVELS
+{
+    { "debug", LogLevel::Debug },
+    { "intel", LogLevel::Intel },
+    { "alert", LogLevel::Alert },
+    { "off",   LogLevel::Off }
+};
+
 const std::unordered_map<std::string, Event> COMMAND_EVENTS
 {
     { "exit",           Event::FadeAndTerminate },
@@ -19,6 +27,7 @@ const std::unordered_map<std::string, Event> COMMAND_EVENTS
     { "vsync",          Event::SetVSync },
     { "fullscreen",     Event::SetFullscreen },
     { "volume",         Event::SetAudioVolume },
+    { "aa",             Event::SetAntiAliasing },
     { "tfmul",          Event::SetTFMul },
     { "menu",           Event::LoadMenu },
     { "load_level",     Event::LoadLevel },
@@ -195,7 +204,9 @@ void Executor::execute(const std::string command)
             "F4 - reload level\n"
             "F5 - reload textures\n"
             "F6 - reload soundbuffers\n"
+            "F7 - toggle frame-time graph\n"
             "F8 - reset level (erase and reload)\n"
+            "(in debug, changed files are reloaded automatically)\n"
             "help1 .... technical commands\n"
             "help2 .... level-design commands");
     }
@@ -208,9 +219,11 @@ void Executor::execute(const std::string command)
             "vsync(bool) ...... set vSync\n"
             "fullscreen(bool) . set fullscreen\n"
             "volume(int) ...... set audio volume\n"
+            "aa(mode) ......... set anti-aliasing [off/fxaa/msaa2/msaa4/msaa8]\n"
             "tfmul(mul) ....... set timeflow multiplier\n"
             "list_rsrcs ....... log all loaded resources\n"
             "rsrc_log(bool) ... set resource logging\n"
+            "log_level(level) . set lowest logged level [debug/intel/alert/off]\n"
             "menu.............. load the menu level\n"
             "load_level(path) . load level\n"
             "load_user(ID) .... load user (automatically loads its last level)\n"
@@ -229,6 +242,7 @@ void Executor::execute(const std::string command)
             "lradius(x,sec) ...... set light's radius over period\n"
             "lbrightness(x,sec) .. set light's brightness over period\n"
             "lswing(x,sec) ....... set light's swing over period\n"
+            "(the above accept an easing after sec: [linear/in/out/in_out])\n"
             "lon(bool, sec)....... set light on or off over period\n"
             "list_users .......... log all users\n"
             "advance(ID) ......... increment objective's progress\n"
@@ -254,6 +268,16 @@ void Executor::execute(const std::string command)
         RESOURCE_LOGGING = Convert::str_to<bool>(args);
         LOG_INTEL("resource logging set to: " + Convert::to_str(RESOURCE_LOGGING));
     }
+    else if (command_name == "log_level")
+    {
+        if (contains(KNOWN_LOG_LEVELS, args))
+        {
+            Logger::instance().set_level(KNOWN_LOG_LEVELS.at(args));
+            LOG_ALERT("log level set to: " + args);
+        }
+        else
+            LOG_ALERT("unknown log level: " + args);
+    }
     else if (command_name == "list_users")
     {
         LOG_INTEL("users:\n" + EARManager::instance().request(Request::UserList).as<std::string>());
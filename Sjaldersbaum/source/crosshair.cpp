@@ -114,6 +114,16 @@ void Crosshair::set_center(const PxVec2 center, const bool show)
     }
 }
 
+bool Crosshair::is_idle() const
+{
+    if (size.is_progressing() || center.is_progressing() ||
+        opacity.is_progressing() || color.is_progressing())
+        return false;
+
+    // An unclasped crosshair eventually shrinks back (after an interaction) and fades out:
+    return clasped || (interaction_timer <= 0.f && opacity.get_current() == 0.f);
+}
+
 void Crosshair::set_visible(const bool visible)
 {
     this->visible = visible;
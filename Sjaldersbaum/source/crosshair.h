@@ -28,6 +28,9 @@ public:
 
     void on_interaction();
 
+    // Returns true if the crosshair is not transitioning, nor waiting to shrink or fade out.
+    bool is_idle() const;
+
     void position_crosshair_lines();
 
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
@@ -68,6 +68,11 @@ void Cursor::set_visible(const bool visible, const Seconds delay)
     }
 }
 
+bool Cursor::is_idle() const
+{
+    return !visible.is_progressing();
+}
+
 void Cursor::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
     if (visible.get_current())
@@ -19,6 +19,9 @@ public:
     void set_type(Indicator::Type type);
     void set_visible(bool visible, Seconds delay = 0.f);
 
+    // Returns true if the cursor is not about to appear or disappear.
+    bool is_idle() const;
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
 private:
@@ -16,11 +16,13 @@ constexpr Px LEFT_SIDE_MARGIN = 10.f;
 /*------------------------------------------------------------------------------------------------*/
 
 DebugLog::DebugLog() :
+    first_line{ 0u },
+    line_count{ 0u },
     text_height{ 0.f },
     text_ol_thickness{ 0.f },
     line_height{ 0.f }
 {
-
+    lines.resize(MAX_LINES);
 }
 
 void DebugLog::scroll(const Mouse& mouse)
@@ -29,7 +31,7 @@ void DebugLog::scroll(const Mouse& mouse)
         bg.getGlobalBounds().contains(mouse.get_position_in_window()))
     {
         const Px y_move = mouse.get_wheel_ticks_delta() * (-4.f) * text_height;
-        const Px y_max  = lines.size() * line_height - lines_view.getSize().y / 2.f;
+        const Px y_max  = line_count * line_height - lines_view.getSize().y / 2.f;
 
         PxVec2 center{ lines_view.getCenter().x,
                        lines_view.getCenter().y + y_move };
@@ -79,27 +81,13 @@ void DebugLog::set_properties(const std::string& font_path,
     bg.setFillColor(bg_fill);
     bg.setOutlineColor(bg_ol);
     bg.setOutlineThickness(bg_ol_thickness);
+
+    for (auto& text : line_texts)
+        apply_properties(text);
 }
 
 void DebugLog::write(const std::string& str)
 {
-    if (lines.size() >= MAX_LINES)
-        return;
-
-    auto write_line = [&](const std::string& str)
-    {
-        auto& line = lines.emplace_back(sf::Text());
-
-        line.setString(str);
-        line.setFont(font.get());
-        line.setCharacterSize(static_cast<unsigned int>(text_height));
-        line.setFillColor(text_fill);
-        line.setOutlineColor(text_ol);
-        line.setOutlineThickness(text_ol_thickness);
-
-        line.setPosition(LEFT_SIDE_MARGIN, (lines.size() - 1) * line_height);
-    };
-
     std::stringstream buffer{ str };
     for (std::string line; std::getline(buffer, line);)
     {
@@ -109,13 +97,7 @@ void DebugLog::write(const std::string& str)
             write_line(line.substr(0, MAX_LINE_WIDTH));
             line.erase(0, MAX_LINE_WIDTH);
         }
-        write_line(line);
-
-        if (lines.size() >= MAX_LINES)
-        {
-            write_line("log full; use 'clear'.");
-            break;
-        }
+        write_line(std::move(line));
     }
 
     position_view_to_newest_line();
@@ -124,15 +106,43 @@ void DebugLog::write(const std::string& str)
 
 void DebugLog::clear()
 {
-    lines.clear();
+    first_line = 0u;
+    line_count = 0u;
     position_view_to_newest_line();
     render_visible_lines_to_canvas();
 }
 
+void DebugLog::write_line(std::string str)
+{
+    if (line_count < lines.size())
+        lines[(first_line + line_count++) % lines.size()] = std::move(str);
+    else
+    {
+        // Full; overwrite the oldest line:
+        lines[first_line] = std::move(str);
+        first_line = (first_line + 1u) % lines.size();
+    }
+}
+
+const std::string& DebugLog::get_line(const size_t i) const
+{
+    return lines[(first_line + i) % lines.size()];
+}
+
+void DebugLog::apply_properties(sf::Text& text) const
+{
+    if (font.is_loaded())
+        text.setFont(font.get());
+    text.setCharacterSize(static_cast<unsigned int>(text_height));
+    text.setFillColor(text_fill);
+    text.setOutlineColor(text_ol);
+    text.setOutlineThickness(text_ol_thickness);
+}
+
 void DebugLog::position_view_to_newest_line()
 {
     lines_view.setCenter(lines_view.getSize().x / 2.f,
-                         lines.size() * line_height - lines_view.getSize().y / 2.f);
+                         line_count * line_height - lines_view.getSize().y / 2.f);
 }
 
 void DebugLog::render_visible_lines_to_canvas()
@@ -146,11 +156,19 @@ void DebugLog::render_visible_lines_to_canvas()
     int begin = centered_i - static_cast<int>(std::ceil(visible_lines / 2.f));
     int end   = centered_i + static_cast<int>(std::ceil(visible_lines / 2.f));
 
-    assure_bounds(end,   0, static_cast<int>(lines.size()));
+    assure_bounds(end,   0, static_cast<int>(line_count));
     assure_bounds(begin, 0, end);
 
+    while (line_texts.size() < static_cast<size_t>(end - begin))
+        apply_properties(line_texts.emplace_back());
+
     for (int i = begin; i != end; ++i)
-        lines_canvas.draw(lines[i]);
+    {
+        sf::Text& text = line_texts[static_cast<size_t>(i - begin)];
+        text.setString(get_line(static_cast<size_t>(i)));
+        text.setPosition(LEFT_SIDE_MARGIN, i * line_height);
+        lines_canvas.draw(text);
+    }
 
     lines_canvas.display();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <deque>
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 #include "mouse.h"
@@ -10,6 +11,8 @@
 /*------------------------------------------------------------------------------------------------*/
 
 // Basic text-window for DebugWindow.
+// Lines are stored as plain strings; only the visible ones are turned into sf::Texts, which are
+// reused as the view scrolls.
 class DebugLog : public sf::Drawable
 {
 public:
@@ -26,11 +29,18 @@ public:
                         sf::Color bg_fill,   sf::Color bg_ol,   Px bg_ol_thickness);
 
     // Appends the string to the log. Note that the string may be wrapped.
+    // Once the log is full, the oldest lines are discarded.
     void write(const std::string& str);
 
     void clear();
 
 private:
+    void write_line(std::string str);
+    const std::string& get_line(size_t i) const; // i = 0 is the oldest line.
+
+    // Styles a text for a visible line.
+    void apply_properties(sf::Text& text) const;
+
     void position_view_to_newest_line();
 
     void render_visible_lines_to_canvas();
@@ -40,7 +50,11 @@ private:
 private:
     sf::RectangleShape bg;
 
-    std::deque<sf::Text> lines;
+    std::vector<std::string> lines; // Ring buffer; see first_line.
+    size_t first_line;
+    size_t line_count;
+
+    std::vector<sf::Text> line_texts; // Reused for whichever lines are visible.
     sf::View          lines_view;
     sf::RenderTexture lines_canvas;
     sf::Sprite        lines_sprite;
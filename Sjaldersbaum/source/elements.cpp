@@ -89,48 +89,36 @@ std::shared_ptr<Element> create_element(const YAML::Node& node)
 
 /*------------------------------------------------------------------------------------------------*/
 
-// Returns the index of the character that is closest to the specified point.
-// Note that the returned index is end-inclusive:
-// if the point is beyond the final character, the text's length is returned instead
-// (this specialized behaviour for InputString's end-inclusive indexing).
-size_t find_character_index(const sf::Text& text, const PxVec2 point)
-{
-    size_t closest_char_index = 0;
-    Px closest_char_distance = get_distance(point, text.findCharacterPos(0));
-
-    for (size_t i = 0; i <= text.getString().getSize(); ++i)
-    {
-        const Px distance = get_distance(point, text.findCharacterPos(i));
-        if (distance < closest_char_distance)
-        {
-            closest_char_index = i;
-            closest_char_distance = distance;
-        }
-    }
-
-    return closest_char_index;
-}
-
-/*------------------------------------------------------------------------------------------------*/
 // Image:
 
-Image::Image() : Element(false, Element::Type::Image)
+Image::Image() : Element(false, Element::Type::Image),
+    texture_applied{ false }
 {
 
 }
 
 void Image::update(Seconds elapsed_time)
 {
+    if (!texture_applied && texture.is_ready())
+        apply_texture();
+
     if (this->is_idle())
         return;
 
     opacity.update(elapsed_time);
     if (opacity.has_changed_since_last_check())
         image.setColor(blend(Colors::WHITE_TRANSPARENT, color, opacity.get_current()));
-    if (!opacity.is_progressing())
+    if (!opacity.is_progressing() && texture_applied)
         this->set_idle(true);
 }
 
+void Image::apply_texture()
+{
+    image.setTexture(texture.get(), true);
+    ::set_size(image, this->get_size());
+    texture_applied = true;
+}
+
 void Image::on_reposition()
 {
     if (!this->is_initialized())
@@ -147,21 +135,30 @@ bool Image::on_initialization(const YAML::Node& node)
         const YAML::Node size_node    = node["size"];
         const YAML::Node color_node   = node["color"];
 
-        texture.load(texture_node.IsDefined() ? texture_node.as<std::string>() : SFML_LOGO_PATH);
-        image.setTexture(texture.get(), true);
+        const std::string texture_path =
+            texture_node.IsDefined() ? texture_node.as<std::string>() : SFML_LOGO_PATH;
 
         PxVec2 size;
         if (size_node.IsDefined())
         {
+            // The size does not depend on the texture, so it need not stall the level:
+            texture.load_async(texture_path);
+
             size = size_node.as<PxVec2>();
             if (!(assure_bounds(size.x, 1.f, PX_LIMIT) &
                   assure_bounds(size.y, 1.f, PX_LIMIT)))
                 LOG_ALERT("invalid size had to be adjusted.");
         }
         else
+        {
+            texture.load(texture_path);
             size = PxVec2{ texture.get().getSize() };
+        }
         this->disclose_size(size);
-        ::set_size(image, this->get_size());
+
+        texture_applied = false;
+        if (texture.is_ready())
+            apply_texture();
 
         color = color_node.IsDefined() ? color_node.as<sf::Color>() : Colors::WHITE;
         image.setColor(color);
@@ -238,6 +235,7 @@ bool Text::on_initialization(const YAML::Node& node)
         if (!text_props.initialize(text_props_node))
             throw YAML::Exception{ YAML::Mark::null_mark(), "invalid text_props node." };
         text_props.apply(text);
+        text_props.prewarm(text.getString());
 
         this->disclose_size({ text.getLocalBounds().width, text.getLocalBounds().height });
     }
@@ -500,6 +498,7 @@ bool Button::on_initialization(const YAML::Node& node)
                 if (!text_props.initialize(text_props_node))
                     throw YAML::Exception{ YAML::Mark::null_mark(), "invalid text_props node." };
             text_props.apply(text);
+            text_props.prewarm(text.getString());
             
             const Px height = text_props.get_max_height() + MARGIN;
             stamp_side = { height, height };
@@ -730,7 +729,7 @@ void InputLine::update_indicator_input(const Indicator& indicator)
             indicator.get_latest_input_source() == Indicator::InputSource::Mouse)
             commit_input();
         else
-            input.set_index(find_character_index(text, indicator.get_position()));
+            input.set_index(character_offsets.find_index(text, indicator.get_position()));
     }
 }
 
@@ -756,6 +755,7 @@ void InputLine::update(const Seconds elapsed_time)
     if (input.has_string_been_altered())
     {
         text.setString(this->input.get_string());
+        character_offsets.rebuild(text);
         AudioPlayer::instance().play(input_sound);
     }
     if (input.has_index_been_altered())
@@ -893,7 +893,7 @@ void InputLine::position_underline()
 
 void InputLine::position_caret()
 {
-    caret.set_position({ text.findCharacterPos(input.get_index()).x,
+    caret.set_position({ character_offsets.get_position(text, input.get_index()).x,
                                                this->get_bounds().getBottom() - MARGIN });
 }
 
@@ -999,6 +999,8 @@ bool InputLine::on_initialization(const YAML::Node& node)
             if (!text_props.initialize(text_props_node))
                 throw YAML::Exception{ YAML::Mark::null_mark(), "invalid text_props node." };
         text_props.apply(text);
+        text_props.prewarm(); // Whatever is typed; mostly the common characters.
+        character_offsets.rebuild(text);
 
         if (length_node.IsDefined())
         {
@@ -1036,7 +1038,10 @@ bool InputLine::on_initialization(const YAML::Node& node)
         auto_clear = auto_clear_node.IsDefined() ? auto_clear_node.as<bool>() : false;
 
         if (input.has_string_been_altered())
+        {
             text.setString(input.get_string());
+            character_offsets.rebuild(text);
+        }
         if (input.has_index_been_altered())
             position_caret();
 
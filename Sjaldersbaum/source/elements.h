@@ -58,6 +58,9 @@ public:
     void update(Seconds elapsed_time) override;
 
 private:
+    // Sets up the sprite once the texture is ready.
+    void apply_texture();
+
     void on_reposition() override;
 
     // Expects a map that includes:
@@ -67,12 +70,14 @@ private:
     // ==ADVANCED================================
     // * color: <sf::Color> = <WHITE>
     // ==========================================
+    // If size is specified, the texture is loaded in the background (not drawn until ready).
     bool on_initialization(const YAML::Node& node) override;
 
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
 private:
     TextureReference texture;
+    bool texture_applied;
     sf::Sprite image;
     sf::Color color;
 };
@@ -289,6 +294,7 @@ private:
     Theme theme;
     TextProps text_props;
     sf::Text text;
+    CharacterOffsets character_offsets; // Of text; for the caret.
     
     SoundID input_sound;
 
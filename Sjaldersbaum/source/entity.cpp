@@ -6,6 +6,68 @@
 
 /*------------------------------------------------------------------------------------------------*/
 
+// Entities may draw slightly beyond their bounds (highlight margins, text outlines, carets).
+constexpr Px CULLING_MARGIN = 50.f;
+
+/*------------------------------------------------------------------------------------------------*/
+
+PxRect get_visible_area(const sf::View& view)
+{
+    const sf::FloatRect area = view.getInverseTransform().transformRect({ -1.f, -1.f, 2.f, 2.f });
+    return { area.left, area.top, area.width, area.height };
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+ActiveSet::ActiveSet(Entity* owner) :
+    owner{ owner }
+{
+
+}
+
+void ActiveSet::schedule(Entity& entity)
+{
+    if (entity.scheduled)
+        return;
+
+    entity.scheduled = true;
+    entities.emplace_back(&entity);
+
+    if (owner)
+        owner->set_idle(false);
+}
+
+void ActiveSet::update(const Seconds elapsed_time)
+{
+    // Indexed, as updates may schedule further Entities:
+    for (size_t i = 0; i != entities.size(); ++i)
+        entities[i]->update(elapsed_time);
+
+    std::erase_if(entities, [](Entity* entity)
+    {
+        if (!entity->is_idle())
+            return false;
+
+        entity->scheduled = false;
+        return true;
+    });
+}
+
+void ActiveSet::clear()
+{
+    for (Entity* entity : entities)
+        entity->scheduled = false;
+
+    entities.clear();
+}
+
+bool ActiveSet::is_empty() const
+{
+    return entities.empty();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 Entity::Entity(const EntityConfig& config) :
     reveal_sound  { UNINITIALIZED_SOUND },
     initial_origin{ Origin::Center },
@@ -14,6 +76,8 @@ Entity::Entity(const EntityConfig& config) :
     active        { false },
     idle          { false },
     initialized   { false },
+    scheduler     { nullptr },
+    scheduled     { false },
     config        { config }
 {
 
@@ -72,6 +136,17 @@ void Entity::set_active(const bool active)
 void Entity::set_idle(const bool idle)
 {
     this->idle = idle;
+
+    if (!idle && scheduler)
+        scheduler->schedule(*this);
+}
+
+void Entity::set_scheduler(ActiveSet* scheduler)
+{
+    this->scheduler = scheduler;
+
+    if (!idle && scheduler)
+        scheduler->schedule(*this);
 }
 
 void Entity::disclose_size(const PxVec2 size)
@@ -150,6 +225,15 @@ bool Entity::is_initialized() const
     return initialized;
 }
 
+bool Entity::is_within(const PxRect& area) const
+{
+    const PxRect extended_bounds{ bounds.left   - CULLING_MARGIN,
+                                  bounds.top    - CULLING_MARGIN,
+                                  bounds.width  + CULLING_MARGIN * 2.f,
+                                  bounds.height + CULLING_MARGIN * 2.f };
+    return extended_bounds.intersects(area);
+}
+
 void Entity::render_debug_bounds(sf::RenderTarget& target, const sf::Color color) const
 {
     sf::RectangleShape rectangle;
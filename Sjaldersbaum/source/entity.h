@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 #include "yaml.h"
@@ -48,6 +49,40 @@ constexpr EntityConfig INACTIVATABLE_ELEMENT{ false,
 }
 /*------------------------------------------------------------------------------------------------*/
 
+// Returns the area (in table coordinates) portrayed by view; used for culling.
+PxRect get_visible_area(const sf::View& view);
+
+/*------------------------------------------------------------------------------------------------*/
+
+class Entity;
+
+// The Entities of a container that are not idle; only these have to be updated with time input.
+// An Entity schedules itself once it loses its idleness (see Entity::set_scheduler()),
+// and is dropped once an update leaves it idle; i.e. the cost of updating scales with activity.
+// Scheduling an Entity also wakes the owner (the container), if it is an Entity itself.
+class ActiveSet
+{
+public:
+    explicit ActiveSet(Entity* owner = nullptr);
+
+    void schedule(Entity& entity);
+
+    // Updates the scheduled Entities, then drops those that became idle.
+    // Note that Entities scheduled during the update are updated as well.
+    void update(Seconds elapsed_time);
+
+    // Unschedules all Entities; to be called before they are destroyed.
+    void clear();
+
+    bool is_empty() const;
+
+private:
+    Entity* owner;
+    std::vector<Entity*> entities;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 // Base for anything that exists on the Table.
 class Entity : public sf::Drawable, public YAML::Serializable
 {
@@ -72,6 +107,10 @@ public:
     void set_active(bool active);
     void set_idle(bool idle);
 
+    // Once the Entity loses its idleness, it schedules itself to be updated by scheduler.
+    // Containers assign their own ActiveSet to the Entities they update; nullptr detaches.
+    void set_scheduler(ActiveSet* scheduler);
+
     // Entity sizes are static and determined BY the derived object upon initialization.
     // i.e: This method is used to inform the Entity of its own size, not set it.
     void disclose_size(PxVec2 size);
@@ -89,6 +128,10 @@ public:
     bool is_idle() const;
     bool is_initialized() const;
 
+    // Returns true if the bounds, extended by a small margin (highlights, outlines, etc.),
+    // intersect with area; i.e. if the Entity has to be drawn when area is viewed.
+    bool is_within(const PxRect& area) const;
+
     void render_debug_bounds(sf::RenderTarget& target, sf::Color color) const;
 
     // Expects a map that consists of:
@@ -136,5 +179,9 @@ private:
     bool idle;
     bool initialized;
 
+    ActiveSet* scheduler;
+    bool scheduled;
+    friend class ActiveSet;
+
     const EntityConfig& config;
 };
\ No newline at end of file
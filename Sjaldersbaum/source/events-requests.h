@@ -18,6 +18,7 @@ enum class Event
     SetVSync,               // bool
     SetFullscreen,          // bool
     SetAudioVolume,         // int
+    SetAntiAliasing,        // AntiAliasing mode as std::string
     SetTFMul,               // float
     SetLoadingScreen,       // bool
     LoadMenu,               // -
@@ -54,6 +55,7 @@ enum class Event
 
     // Game events:
     UserListUpdated,        // -
+    FileChanged,            // file path as std::string (debug only; see FileWatcher)
 };
 
 enum class Request
@@ -63,6 +65,7 @@ enum class Request
     VSync,                  // bool
     Fullscreen,             // bool
     AudioVolume,            // int
+    AntiAliasing,           // AntiAliasing mode as std::string
 
     ActiveUser,             // user's ID
     UserList                // std::string
@@ -0,0 +1,193 @@
+#include "file_watcher.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "logger.h"
+
+namespace fs = std::filesystem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+#ifndef __linux__
+// Stat-ing every watched file is not free; twice a second is responsive enough for editing.
+constexpr Seconds POLL_INTERVAL = 0.5f;
+#endif
+
+/*------------------------------------------------------------------------------------------------*/
+
+// "resources//textures/./table.png" -> "resources/textures/table.png"
+std::string get_normalized_path(const std::string& path)
+{
+    return fs::path{ path }.lexically_normal().generic_string();
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+FileWatcher& FileWatcher::instance()
+{
+    static FileWatcher singleton;
+    return singleton;
+}
+
+FileWatcher::FileWatcher() :
+    enabled{ false },
+#ifdef __linux__
+    inotify_fd{ -1 }
+#else
+    poll_timer{ 0.f }
+#endif
+{
+
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (inotify_fd != -1)
+        close(inotify_fd);
+#endif
+}
+
+void FileWatcher::enable()
+{
+    if (enabled)
+        return;
+
+#ifdef __linux__
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd == -1)
+    {
+        LOG_ALERT("file watcher could not be initialized: " + std::strerror(errno));
+        return;
+    }
+#endif
+
+    enabled = true;
+    for (auto& [normalized_path, file] : files)
+        start_watching(normalized_path, file);
+
+    LOG_INTEL("file watcher enabled; changed resources are reloaded automatically.");
+}
+
+void FileWatcher::watch(const std::string& path)
+{
+    if (path.empty())
+        return;
+
+    std::string normalized_path = get_normalized_path(path);
+
+    if (auto it = files.find(normalized_path); it != files.end())
+    {
+        auto& spellings = it->second.spellings;
+        if (std::find(spellings.begin(), spellings.end(), path) == spellings.end())
+            spellings.push_back(path);
+        return;
+    }
+
+    const auto [it, inserted] = files.emplace(std::move(normalized_path), WatchedFile{ { path }, {} });
+    if (enabled)
+        start_watching(it->first, it->second);
+}
+
+// elapsed_time only drives polling; inotify reports changes as they happen.
+void FileWatcher::update([[maybe_unused]] const Seconds elapsed_time)
+{
+    if (!enabled)
+        return;
+
+#ifdef __linux__
+    // Events are variable in size (the file name follows), hence the raw buffer:
+    alignas(inotify_event) char buffer[4096];
+
+    while (true)
+    {
+        const ssize_t length = read(inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) // EAGAIN; no more pending events.
+            break;
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0)
+                continue;
+
+            if (auto it = watched_directories.find(event->wd); it != watched_directories.end())
+                mark_changed((fs::path{ it->second } / event->name).generic_string());
+        }
+    }
+#else
+    poll_timer += elapsed_time;
+    if (poll_timer < POLL_INTERVAL)
+        return;
+    poll_timer = 0.f;
+
+    for (auto& [normalized_path, file] : files)
+    {
+        std::error_code error;
+        const fs::file_time_type last_write_time = fs::last_write_time(normalized_path, error);
+
+        if (!error && last_write_time != file.last_write_time)
+        {
+            file.last_write_time = last_write_time;
+            mark_changed(normalized_path);
+        }
+    }
+#endif
+}
+
+std::vector<std::string> FileWatcher::extract_changed_paths()
+{
+    std::vector<std::string> changed_paths;
+
+    for (const auto& normalized_path : changed_files)
+    {
+        const auto& spellings = files.at(normalized_path).spellings;
+        changed_paths.insert(changed_paths.end(), spellings.begin(), spellings.end());
+    }
+    changed_files.clear();
+
+    return changed_paths;
+}
+
+// file only records the write time for polling; inotify needs no per-file state.
+void FileWatcher::start_watching(const std::string& normalized_path,
+                                 [[maybe_unused]] WatchedFile& file)
+{
+#ifdef __linux__
+    // inotify watches directories; events of unwatched files within them are simply ignored.
+    const std::string directory = fs::path{ normalized_path }.parent_path().generic_string();
+    if (directories.count(directory) != 0)
+        return;
+
+    // Editors either write files in place, or write a copy and move it over the original:
+    const int watch_descriptor = inotify_add_watch(inotify_fd,
+                                                   directory.empty() ? "." : directory.c_str(),
+                                                   IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_descriptor == -1)
+    {
+        LOG_INTEL("directory could not be watched: " + directory);
+        return;
+    }
+
+    directories.insert(directory);
+    watched_directories.emplace(watch_descriptor, directory);
+#else
+    std::error_code error;
+    file.last_write_time = fs::last_write_time(normalized_path, error);
+#endif
+}
+
+void FileWatcher::mark_changed(const std::string& normalized_path)
+{
+    if (files.count(normalized_path) != 0)
+        changed_files.insert(normalized_path);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+
+#include "units.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Singleton for noticing when files on the drive change; used to hot-reload assets in debug mode.
+// Uses inotify on Linux; elsewhere, the last write times of watched files are polled.
+class FileWatcher
+{
+public:
+    static FileWatcher& instance();
+
+    // Paths are only recorded until the watcher is enabled, so watch() is cheap outside debug mode.
+    void enable();
+
+    // Starts watching the file at path; does nothing if it is watched already.
+    void watch(const std::string& path);
+
+    // Gathers changes that occurred since the last call. Call once per loop.
+    void update(Seconds elapsed_time);
+
+    // Returns the paths (spelled as they were passed to watch()) of all files that changed
+    // since the last call; each path is returned only once, regardless of how often it changed.
+    std::vector<std::string> extract_changed_paths();
+
+private:
+    struct WatchedFile
+    {
+        std::vector<std::string> spellings;
+        std::filesystem::file_time_type last_write_time;
+    };
+
+    // Registers file (by its normalized path) with the OS, or records its last write time.
+    void start_watching(const std::string& normalized_path, WatchedFile& file);
+
+    void mark_changed(const std::string& normalized_path);
+
+private:
+    std::unordered_map<std::string, WatchedFile> files; // By normalized path.
+    std::unordered_set<std::string> changed_files;      // Normalized paths.
+    bool enabled;
+
+#ifdef __linux__
+    int inotify_fd;
+    std::unordered_map<int, std::string> watched_directories; // Watch descriptor -> directory.
+    std::unordered_set<std::string> directories;
+#else
+    Seconds poll_timer;
+#endif
+
+private:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher(FileWatcher&&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher& operator=(FileWatcher&&) = delete;
+};
@@ -0,0 +1,187 @@
+#include "frame_graph.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "frame_profiler.h"
+#include "colors.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+constexpr Seconds STATS_UPDATE_INTERVAL = 0.25f;
+
+const PxVec2 GRAPH_POSITION{ 1.f, 20.f }; // Below the FPS_Display.
+const PxVec2 GRAPH_SIZE    { 360.f, 100.f };
+
+constexpr Seconds GRAPH_MAX_FRAME_TIME = 1.f / 20.f; // Taller frames are clipped.
+
+// Colors of the stacked sections; the rest of a frame (e.g. event handling) is drawn as "other":
+const std::array<sf::Color, static_cast<size_t>(FrameSection::Count)> SECTION_COLORS
+{
+    sf::Color{  80, 160, 255 }, // Update
+    sf::Color{  80, 220, 100 }, // Render
+    sf::Color{ 255, 210,  60 }, // LightPass
+    sf::Color{ 130, 130, 130 }  // Display
+};
+const sf::Color OTHER_COLOR{ 220, 80, 200 };
+
+/*------------------------------------------------------------------------------------------------*/
+
+// e.g. 0.0166 -> "16.6"
+std::string format_milliseconds(const Seconds seconds)
+{
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%.1f", seconds * 1000.f);
+    return buffer;
+}
+
+// Expects sorted values.
+Seconds get_percentile(const std::vector<Seconds>& values, const float percentile)
+{
+    const size_t i = static_cast<size_t>(percentile * static_cast<float>(values.size()));
+    return values[std::min(i, values.size() - 1u)];
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+FrameGraph::FrameGraph() :
+    bars{ sf::Quads },
+    budget_lines{ sf::Lines, 4u },
+    update_lag{ 0.f },
+    visible{ false }
+{
+
+}
+
+void FrameGraph::initialize()
+{
+    font.load(SYSTEM_FONT_PATH);
+
+    bg.setPosition(GRAPH_POSITION);
+    bg.setSize(GRAPH_SIZE);
+    bg.setFillColor(Colors::BLACK_SEMI_TRANSPARENT);
+    bg.setOutlineColor(Colors::BLACK);
+    bg.setOutlineThickness(1.f);
+
+    const Px bottom = GRAPH_POSITION.y + GRAPH_SIZE.y;
+    const std::array<Seconds, 2u> budgets{ 1.f / 60.f, 1.f / 30.f };
+    for (size_t i = 0u; i < budgets.size(); ++i)
+    {
+        const Px y = bottom - GRAPH_SIZE.y * budgets[i] / GRAPH_MAX_FRAME_TIME;
+        budget_lines[i * 2u]      = sf::Vertex{ { GRAPH_POSITION.x,                y }, Colors::WHITE_SEMI_TRANSPARENT };
+        budget_lines[i * 2u + 1u] = sf::Vertex{ { GRAPH_POSITION.x + GRAPH_SIZE.x, y }, Colors::WHITE_SEMI_TRANSPARENT };
+    }
+
+    stats.setFont(font.get());
+    stats.setFillColor(Colors::GREEN);
+    stats.setOutlineColor(Colors::BLACK);
+    stats.setOutlineThickness(1.f);
+    stats.setCharacterSize(12u);
+    stats.setPosition(GRAPH_POSITION.x, bottom + 2.f);
+}
+
+void FrameGraph::toggle_visible()
+{
+    visible = !visible;
+}
+
+void FrameGraph::update(const Seconds elapsed_time)
+{
+    if (!visible)
+        return;
+
+    rebuild_bars();
+
+    update_lag += elapsed_time;
+    if (update_lag >= STATS_UPDATE_INTERVAL)
+    {
+        rebuild_stats();
+        update_lag = 0.f;
+    }
+}
+
+void FrameGraph::rebuild_bars()
+{
+    const auto history = FrameProfiler::instance().get_history();
+    const Px bar_width  = GRAPH_SIZE.x / static_cast<Px>(history.size());
+    const Px bottom     = GRAPH_POSITION.y + GRAPH_SIZE.y;
+    const Px px_per_sec = GRAPH_SIZE.y / GRAPH_MAX_FRAME_TIME;
+
+    bars.clear();
+
+    auto add_segment = [&](const Px left, const Px from, const Px to, const sf::Color color)
+    {
+        const Px segment_top    = std::max(bottom - to,   GRAPH_POSITION.y);
+        const Px segment_bottom = std::max(bottom - from, GRAPH_POSITION.y);
+        if (segment_bottom - segment_top < 0.5f)
+            return;
+
+        bars.append({ { left,             segment_top },    color });
+        bars.append({ { left + bar_width, segment_top },    color });
+        bars.append({ { left + bar_width, segment_bottom }, color });
+        bars.append({ { left,             segment_bottom }, color });
+    };
+
+    for (size_t i = 0u; i < history.size(); ++i)
+    {
+        const FrameRecord& record = history[i];
+        const Px left = GRAPH_POSITION.x + bar_width * static_cast<Px>(i);
+
+        Px height = 0.f;
+        for (size_t section = 0u; section < record.sections.size(); ++section)
+        {
+            const Px section_height = record.sections[section] * px_per_sec;
+            add_segment(left, height, height + section_height, SECTION_COLORS[section]);
+            height += section_height;
+        }
+        add_segment(left, height, record.frame_time * px_per_sec, OTHER_COLOR);
+    }
+}
+
+void FrameGraph::rebuild_stats()
+{
+    const auto history = FrameProfiler::instance().get_history();
+
+    std::vector<Seconds> frame_times;
+    std::array<Seconds, static_cast<size_t>(FrameSection::Count)> section_totals{};
+    for (const auto& record : history)
+    {
+        if (record.frame_time <= 0.f)
+            continue; // Not recorded yet.
+
+        frame_times.push_back(record.frame_time);
+        for (size_t section = 0u; section < record.sections.size(); ++section)
+            section_totals[section] += record.sections[section];
+    }
+
+    if (frame_times.empty())
+        return;
+
+    std::sort(frame_times.begin(), frame_times.end());
+
+    auto get_average = [&](const FrameSection section)
+    {
+        return section_totals[static_cast<size_t>(section)] / static_cast<float>(frame_times.size());
+    };
+
+    stats.setString(
+        "ms  p50 "  + format_milliseconds(get_percentile(frame_times, 0.5f))  +
+        "  p95 "    + format_milliseconds(get_percentile(frame_times, 0.95f)) +
+        "  p99 "    + format_milliseconds(get_percentile(frame_times, 0.99f)) +
+        "  max "    + format_milliseconds(frame_times.back()) +
+        "\navg  update " + format_milliseconds(get_average(FrameSection::Update))    +
+        "  render "      + format_milliseconds(get_average(FrameSection::Render))    +
+        "  light "       + format_milliseconds(get_average(FrameSection::LightPass)) +
+        "  display "     + format_milliseconds(get_average(FrameSection::Display)));
+}
+
+void FrameGraph::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (!visible)
+        return;
+
+    target.draw(bg);
+    target.draw(bars);
+    target.draw(budget_lines);
+    target.draw(stats);
+}
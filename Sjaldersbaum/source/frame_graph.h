@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "resources.h"
+#include "units.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Overlay (below FPS_Display) that graphs the times of recent frames, stacked by FrameSection,
+// and lists their percentiles; unlike an average FPS, it shows individual stutters.
+// Data is gathered by FrameProfiler.
+class FrameGraph : public sf::Drawable
+{
+public:
+    FrameGraph();
+
+    void initialize();
+
+    void toggle_visible();
+
+    void update(Seconds elapsed_time);
+
+private:
+    void rebuild_bars();
+
+    void rebuild_stats();
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    FontReference font;
+    sf::RectangleShape bg;
+    sf::VertexArray bars;
+    sf::VertexArray budget_lines; // At 60 and 30 FPS.
+    sf::Text stats;
+
+    Seconds update_lag;
+    bool visible;
+};
@@ -0,0 +1,81 @@
+#include "frame_profiler.h"
+
+#include "time_and_date.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+constexpr size_t HISTORY_LENGTH = 240u; // Frames; a few seconds' worth.
+
+/*------------------------------------------------------------------------------------------------*/
+
+FrameProfiler& FrameProfiler::instance()
+{
+    static FrameProfiler singleton;
+    return singleton;
+}
+
+FrameProfiler::FrameProfiler() :
+    history(HISTORY_LENGTH),
+    next_record{ 0u },
+    enabled{ false }
+{
+
+}
+
+void FrameProfiler::enable()
+{
+    enabled = true;
+}
+
+bool FrameProfiler::is_enabled() const
+{
+    return enabled;
+}
+
+void FrameProfiler::add(const FrameSection section, const Seconds duration)
+{
+    current.sections[static_cast<size_t>(section)] += duration;
+}
+
+void FrameProfiler::end_frame(const Seconds frame_time)
+{
+    if (!enabled)
+        return;
+
+    // The light pass was timed within rendering:
+    Seconds& render = current.sections[static_cast<size_t>(FrameSection::Render)];
+    render -= current.sections[static_cast<size_t>(FrameSection::LightPass)];
+    if (render < 0.f)
+        render = 0.f;
+
+    current.frame_time = frame_time;
+    history[next_record] = current;
+    next_record = (next_record + 1u) % history.size();
+
+    current = FrameRecord{};
+}
+
+std::vector<FrameRecord> FrameProfiler::get_history() const
+{
+    std::vector<FrameRecord> ordered_history;
+    ordered_history.reserve(history.size());
+    ordered_history.insert(ordered_history.end(), history.begin() + next_record, history.end());
+    ordered_history.insert(ordered_history.end(), history.begin(), history.begin() + next_record);
+    return ordered_history;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+SectionTimer::SectionTimer(const FrameSection section) :
+    section{ section },
+    start_ns{ FrameProfiler::instance().is_enabled() ? Time::get_absolute_ns() : 0 }
+{
+
+}
+
+SectionTimer::~SectionTimer()
+{
+    if (start_ns != 0)
+        FrameProfiler::instance().add(
+            section, static_cast<Seconds>((Time::get_absolute_ns() - start_ns) * SECONDS_IN_NANOSECOND));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "units.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Parts of a frame whose durations are recorded. Note that the light pass is part of rendering;
+// FrameProfiler excludes it from FrameSection::Render, so that sections stack up to the frame.
+enum class FrameSection
+{
+    Update,
+    Render,
+    LightPass,
+    Display, // window.display(); i.e. waiting for vSync, the FPS cap or the GPU.
+
+    Count
+};
+
+struct FrameRecord
+{
+    Seconds frame_time = 0.f;
+    std::array<Seconds, static_cast<size_t>(FrameSection::Count)> sections{};
+};
+
+// Singleton that records how long the sections of recent frames took; see FrameGraph.
+class FrameProfiler
+{
+public:
+    static FrameProfiler& instance();
+
+    // Nothing is recorded until enabled (in debug mode), so timers are nearly free otherwise.
+    void enable();
+    bool is_enabled() const;
+
+    void add(FrameSection section, Seconds duration);
+
+    // Closes the current frame's record. Call once per loop, with the (unscaled) frame time.
+    void end_frame(Seconds frame_time);
+
+    // Oldest to newest.
+    std::vector<FrameRecord> get_history() const;
+
+private:
+    std::vector<FrameRecord> history; // Ring buffer; see next_record.
+    size_t next_record;
+    FrameRecord current;
+    bool enabled;
+
+private:
+    FrameProfiler();
+    ~FrameProfiler() = default;
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler(FrameProfiler&&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(FrameProfiler&&) = delete;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Adds the time between its construction and destruction to a section of the current frame.
+class SectionTimer
+{
+public:
+    SectionTimer(FrameSection section);
+    ~SectionTimer();
+
+    SectionTimer(const SectionTimer&) = delete;
+    SectionTimer& operator=(const SectionTimer&) = delete;
+
+private:
+    FrameSection section;
+    long long start_ns; // 0 if the profiler is disabled.
+};
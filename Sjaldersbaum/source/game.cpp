@@ -9,6 +9,7 @@
 #include "string_assist.h"
 #include "convert.h"
 #include "level_paths.h"
+#include "file_watcher.h"
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -122,9 +123,14 @@ void Game::update(const Seconds elapsed_time)
     level_player.update(elapsed_time);
 }
 
-void Game::render(sf::RenderWindow& window)
+void Game::save_interpolation_state()
 {
-    level_player.render(window);
+    level_player.save_interpolation_state();
+}
+
+void Game::render(sf::RenderWindow& window, const float interpolation)
+{
+    level_player.render(window, interpolation);
     window.draw(menu_bar);
 }
 
@@ -134,6 +140,22 @@ void Game::set_resolution(const PxVec2 resolution)
     level_player.set_resolution(resolution);
 }
 
+void Game::set_antialiasing(const AntiAliasing antialiasing)
+{
+    level_player.set_antialiasing(antialiasing);
+}
+
+void Game::set_light_swing_paused(const bool paused)
+{
+    level_player.set_light_swing_paused(paused);
+}
+
+bool Game::is_idle(const bool count_light_swing) const
+{
+    return background_state == BackgroundState::None && menu_bar.is_idle() &&
+           level_player.is_idle(count_light_swing);
+}
+
 void Game::save()
 {
     User::save_user_list();
@@ -330,6 +352,8 @@ void Game::load_level(std::string level_path)
 
     user.last_level_path = level_path;
     try_execute_stored_command_sequences();
+
+    FileWatcher::instance().watch(level_path);
 }
 
 void Game::save_current_level() const
@@ -380,6 +404,17 @@ void Game::on_event(const Event event, const Data& data)
 
     else if (event == Event::StoreCommandSequence)
         try_store_command_sequence(data.as<std::string>());
+
+    // Like RELOAD_ACTIVE_LEVEL, but triggered by saving the level file:
+    else if (event == Event::FileChanged)
+    {
+        if (data.as<std::string>() == level_player.get_loaded_level_path() &&
+            background_state == BackgroundState::None)
+        {
+            save_current_level();
+            load_level(level_player.get_loaded_level_path());
+        }
+    }
 }
 
 void Game::on_request(const Request request, Data& data)
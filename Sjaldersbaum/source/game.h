@@ -24,10 +24,23 @@ public:
     void update_mouse_input(const Mouse& mouse);
     void update(Seconds elapsed_time);
 
-    void render(sf::RenderWindow& window);
+    // Records the state that rendering interpolates from; call before each simulation step.
+    void save_interpolation_state();
+
+    // See LevelPlayer::render().
+    void render(sf::RenderWindow& window, float interpolation);
 
     void set_resolution(PxVec2 resolution);
 
+    void set_antialiasing(AntiAliasing antialiasing);
+
+    // See LevelPlayer::set_light_swing_paused().
+    void set_light_swing_paused(bool paused);
+
+    // Returns true if neither the menu bar nor the level change over time, and no level is about
+    // to be left; see LevelPlayer::is_idle().
+    bool is_idle(bool count_light_swing = true) const;
+
     void save();
 
     void initialize_debug_components();
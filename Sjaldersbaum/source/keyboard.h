@@ -81,6 +81,7 @@ const Keybind TOGGLE_FPS_DISPLAY    { sf::Keyboard::F3 };
 const Keybind RELOAD_ACTIVE_LEVEL   { sf::Keyboard::F4 };
 const Keybind RELOAD_TEXTURES       { sf::Keyboard::F5 };
 const Keybind RELOAD_SOUNDBUFFERS   { sf::Keyboard::F6 };
+const Keybind TOGGLE_FRAME_GRAPH    { sf::Keyboard::F7 };
 const Keybind RESET_ACTIVE_LEVEL    { sf::Keyboard::F8 };
 
 const Keybind GRANT_DEBUG_RIGHTS    { sf::Keyboard::F12, Keybind::Modifier::ControlAndAlt };
@@ -16,6 +16,8 @@
 #include "string_assist.h"
 #include "units.h"
 #include "level_paths.h"
+#include "text_props.h"
+#include "frame_profiler.h"
 
 /*------------------------------------------------------------------------------------------------*/
 // MenuBarData:
@@ -253,6 +255,8 @@ std::unordered_map<ID, std::string> get_system_macros()
       AS_YAML_STR(EARManager::instance().request(Request::Fullscreen).as<std::string>()) },
     { "__VOLUME",
     AS_YAML_STR(EARManager::instance().request(Request::AudioVolume).as<std::string>()) },
+    { "__ANTIALIASING",
+      AS_YAML_STR(EARManager::instance().request(Request::AntiAliasing).as<std::string>()) },
     { "__ACTIVE_USER",
       AS_YAML_STR(EARManager::instance().request(Request::ActiveUser).as<std::string>()) },
     { "__MENU_PATH",
@@ -286,12 +290,21 @@ const ParticleExplosion MOUSE_EXPLOSION{ Colors::BLACK, Colors::BLACK_SEMI_TRANS
 const ParticleExplosion MOUSE_BIG_EXPLOSION{ Colors::BLACK, Colors::BLACK_SEMI_TRANSPARENT,
                                              100.f, 0.6f };
 
+const std::unordered_map<std::string, Easing> KNOWN_EASINGS
+{
+    { "linear", Easing::Linear },
+    { "in",     Easing::In },
+    { "out",    Easing::Out },
+    { "in_out", Easing::InOut }
+};
+
 LevelPlayer::LevelPlayer() :
     clasp_cooldown              { 0.f },
     clasp_duration              { 0.f },
     mouse_grab_duration         { 0.f },
     tab_cooldown                { 0.f },
     interaction_key_lag         { DOUBLE_CLICK_INTERVAL },
+    antialiasing                { AntiAliasing::MSAA4 },
     level_loaded                { false },
     debug_components_initialized{ false },
     debug_mode                  { false }
@@ -488,9 +501,7 @@ void LevelPlayer::update(const Seconds elapsed_time)
     /*--------------------------------------------------------------------------------------------*/
     // Objects:
 
-    for (const auto& [id, object] : objects)
-        if (!object->is_idle())
-            object->update(elapsed_time);
+    active_objects.update(elapsed_time);
 }
 
 void LevelPlayer::set_light_on(const bool on, const Seconds transition_duration, const bool sound)
@@ -498,6 +509,11 @@ void LevelPlayer::set_light_on(const bool on, const Seconds transition_duration,
     light.set_on(on, transition_duration, sound);
 }
 
+void LevelPlayer::set_light_swing_paused(const bool paused)
+{
+    light.set_swing_paused(paused);
+}
+
 void LevelPlayer::set_resolution(const PxVec2 resolution)
 {
     camera.set_resolution(resolution);
@@ -506,15 +522,23 @@ void LevelPlayer::set_resolution(const PxVec2 resolution)
     if (level_loaded)
         scale_and_position_overlays();
 
-    static const sf::ContextSettings base_settings{ 0, 0, 4 };
+    create_canvases();
+}
+
+void LevelPlayer::set_antialiasing(const AntiAliasing antialiasing)
+{
+    if (this->antialiasing == antialiasing)
+        return;
 
-    base_canvas.create(static_cast<unsigned int>(resolution.x),
-                       static_cast<unsigned int>(resolution.y),
-                       base_settings);
-    final_canvas.create(static_cast<unsigned int>(resolution.x),
-                        static_cast<unsigned int>(resolution.y));
+    const bool recreate = get_msaa_level(this->antialiasing) != get_msaa_level(antialiasing);
+    this->antialiasing = antialiasing;
 
-    final_sprite.setTexture(final_canvas.getTexture(), true);
+    light.set_fxaa(antialiasing == AntiAliasing::FXAA);
+    base_canvas.setSmooth(antialiasing == AntiAliasing::FXAA);
+
+    // Canvases do not exist until the first set_resolution() call.
+    if (recreate && base_canvas.getSize().x != 0)
+        create_canvases();
 }
 
 bool LevelPlayer::load(const std::string& level_path, const std::string& save_path)
@@ -633,6 +657,12 @@ bool LevelPlayer::load(const std::string& level_path, const std::string& save_pa
     if (level_path == LevelPaths::MAIN_MENU)
         insert_user_list_into_menu_level();
 
+    // Rendering must not interpolate from the previous level:
+    save_interpolation_state();
+
+    // Rasterize the glyphs the level's texts will show, rather than during its first frames:
+    GlyphPrewarmer::instance().prewarm();
+
     // Finish:
 
     loaded_level_path = level_path;
@@ -694,19 +724,43 @@ bool LevelPlayer::save(const std::string& save_path) const
     return true;
 }
 
-void LevelPlayer::render(sf::RenderTarget& target)
+void LevelPlayer::save_interpolation_state()
 {
+    camera.save_interpolation_state();
+    light.save_interpolation_state();
+}
+
+void LevelPlayer::render(sf::RenderTarget& target, const float interpolation)
+{
+    const sf::View view = camera.get_interpolated_view(interpolation);
+
+    // Whatever follows the camera (the crosshair and clasped or grabbed objects) is shifted along,
+    // so that it does not trail behind the interpolated view:
+    sf::RenderStates camera_anchored_states;
+    camera_anchored_states.transform.translate(view.getCenter() - camera.get_center());
+
     /*--------------------------------------------------------------------------------------------*/
     // Draw the base canvas (a RenderTexture portraying the currently viewed region of the table):
 
     base_canvas.clear(Colors::BLACK);
 
-    base_canvas.setView(camera.get_view());
+    base_canvas.setView(view);
     base_canvas.draw(table);
+
+    // Cull Objects outside of the view (Sheets further cull their Elements):
+    const PxRect visible_area = get_visible_area(view);
     for (const auto& [id, object] : objects)
-        base_canvas.draw(*object);
+    {
+        if (!object->is_within(visible_area))
+            continue;
+
+        if (object == clasped_object || object == mouse_grabbed_object)
+            base_canvas.draw(*object, camera_anchored_states);
+        else
+            base_canvas.draw(*object);
+    }
     base_canvas.draw(indicator_particles);
-    base_canvas.draw(crosshair);
+    base_canvas.draw(crosshair, camera_anchored_states);
 
     base_canvas.setView(GUI_view);
     base_canvas.draw(tlc_overlay);
@@ -717,7 +771,10 @@ void LevelPlayer::render(sf::RenderTarget& target)
     /*--------------------------------------------------------------------------------------------*/
     // Shaders + final draw:
 
-    light.apply(base_canvas, final_canvas, camera.get_view());
+    {
+        SectionTimer timer{ FrameSection::LightPass };
+        light.apply(base_canvas, final_canvas, view, interpolation);
+    }
     target.draw(final_sprite);
 
     /*--------------------------------------------------------------------------------------------*/
@@ -725,7 +782,7 @@ void LevelPlayer::render(sf::RenderTarget& target)
 
     if (debug_mode)
     {
-        target.setView(camera.get_view());
+        target.setView(view);
 
         light.render_debug_lines(target);
         if (hovered_object)
@@ -762,6 +819,15 @@ bool LevelPlayer::has_level_loaded() const
     return level_loaded;
 }
 
+bool LevelPlayer::is_idle(const bool count_light_swing) const
+{
+    if (!camera.is_idle() || !crosshair.is_idle() || !light.is_idle(count_light_swing) ||
+        !indicator_particles.is_idle())
+        return false;
+
+    return active_objects.is_empty();
+}
+
 void LevelPlayer::initialize_debug_components()
 {
     debug_components_initialized = true;
@@ -811,7 +877,7 @@ void LevelPlayer::set_topmost_object(std::shared_ptr<Object> object)
         ID object_id = get_object_id(object);
         if (object_id.empty())
         {
-            LOG_ALERT("unexpected empty ID.");
+            LOG_ALERT_ONCE("unexpected empty ID.");
             return;
         }
 
@@ -983,6 +1049,11 @@ void LevelPlayer::mouse_ungrab()
 
 void LevelPlayer::clear_objects()
 {
+    // Objects may outlive the level through lingering references, so detach them:
+    for (const auto& [id, object] : objects)
+        object->set_scheduler(nullptr);
+    active_objects.clear();
+
     objects.clear();
     active_object.reset();
     hovered_object.reset();
@@ -1017,6 +1088,22 @@ void LevelPlayer::scale_and_position_overlays()
     brc_overlay.setPosition(GUI_view.getSize());
 }
 
+void LevelPlayer::create_canvases()
+{
+    const sf::ContextSettings base_settings{ 0, 0, get_msaa_level(antialiasing) };
+
+    const unsigned int width  = static_cast<unsigned int>(GUI_view.getSize().x);
+    const unsigned int height = static_cast<unsigned int>(GUI_view.getSize().y);
+
+    base_canvas.create(width, height, base_settings);
+    final_canvas.create(width, height);
+
+    // FXAA samples between texels, which requires a bilinear filter on the source canvas.
+    base_canvas.setSmooth(antialiasing == AntiAliasing::FXAA);
+
+    final_sprite.setTexture(final_canvas.getTexture(), true);
+}
+
 void LevelPlayer::insert_user_list_into_menu_level()
 {
     // Note that this is the only hard-coded relationship the engine has with a level:
@@ -1110,6 +1197,15 @@ void LevelPlayer::on_event(const Event event, const Data& data)
     else if (event == Event::SetLightShader)
         light.set_shader(data.as<std::string>());
 
+    else if (event == Event::FileChanged)
+    {
+        if (light.is_shader_source(data.as<std::string>()))
+            light.set_shader(light.get_shader_path());
+
+        if (table.uses_texture(data.as<std::string>()))
+            table.reload_texture();
+    }
+
     // All of the following commands share the 'progression_duration' parameter.
     else if (event == Event::SetCameraCenter ||
              event == Event::ZoomIn ||
@@ -1124,42 +1220,53 @@ void LevelPlayer::on_event(const Event event, const Data& data)
 
         Seconds progression_duration = 0.f;
         char comma;
+
+        // The duration may be followed by an easing; linear by default:
+        const auto read_easing = [&buffer]()
+        {
+            char comma;
+            std::string easing;
+            if (buffer >> comma >> easing)
+                return Convert::str_to_enum(get_decapitalized(easing), KNOWN_EASINGS);
+            return Easing::Linear;
+        };
+
         if (event == Event::SetCameraCenter)
         {
             PxVec2 center;
             buffer >> center >> comma >> progression_duration;
-            camera.set_center_progressively(center, progression_duration);
+            camera.set_center_progressively(center, progression_duration, read_easing());
         }
         else if (event == Event::ZoomIn || event == Event::ZoomOut)
         {
             buffer >> progression_duration;
             camera.set_zoom_progressively(
                 event == Event::ZoomIn ? Camera::Zoom::In : Camera::Zoom::Out,
-                progression_duration);
+                progression_duration, read_easing());
         }
         else if (event == Event::SetLightSource)
         {
             PxVec2 source;
             buffer >> source >> comma >> progression_duration;
-            light.set_source(source, progression_duration);
+            light.set_source(source, progression_duration, read_easing());
         }
         else if (event == Event::SetLightRadius)
         {
             Px radius;
             buffer >> radius >> comma >> progression_duration;
-            light.set_radius(radius, progression_duration);
+            light.set_radius(radius, progression_duration, read_easing());
         }
         else if (event == Event::SetLightBrightness)
         {
             float brightness;
             buffer >> brightness >> comma >> progression_duration;
-            light.set_brightness(brightness, progression_duration);
+            light.set_brightness(brightness, progression_duration, read_easing());
         }
         else if (event == Event::SetLightSwing)
         {
             Px swing;
             buffer >> swing >> comma >> progression_duration;
-            light.set_swing(swing, progression_duration);
+            light.set_swing(swing, progression_duration, read_easing());
         }
         else if (event == Event::SetLightOn)
         {
@@ -1192,6 +1299,28 @@ bool LevelPlayer::initialize(const YAML::Node& node)
                                          audio_data.playlist_interval,
                                          audio_data.playlist_loudness);
 
+    // Texture policies (must precede anything that loads textures):
+
+    YAML::Node textures_node = node["textures"];
+    if (textures_node.IsDefined() && textures_node.IsMap())
+    {
+        for (auto texture_node : textures_node)
+        {
+            try
+            {
+                const std::string path = texture_node.first.as<std::string>();
+                TextureManager::instance().set_mipmap_policy(path,
+                    Convert::str_to_enum(texture_node.second.as<std::string>(), KNOWN_MIPMAP_POLICIES));
+            }
+            catch (const YAML::Exception& e)
+            {
+                LOG_ALERT("invalid texture policy node; exception: " + e.msg +
+                          "\nDUMP:\n" + YAML::Dump(texture_node));
+                return false;
+            }
+        }
+    }
+
     // Table:
 
     if (!table.initialize(node["table"]))
@@ -1273,6 +1402,7 @@ bool LevelPlayer::initialize(const YAML::Node& node)
             }
 
             table.assure_contains(*object);
+            object->set_scheduler(&active_objects);
             objects.emplace(std::move(id), std::move(object));
         }
     }
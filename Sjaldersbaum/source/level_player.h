@@ -15,6 +15,7 @@
 #include "crosshair.h"
 #include "camera.h"
 #include "resources.h"
+#include "app_settings.h"
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -104,12 +105,23 @@ public:
 
     void set_light_on(bool on, Seconds transition_duration, bool sound = true);
 
+    // See Light::set_swing_paused().
+    void set_light_swing_paused(bool paused);
+
     void set_resolution(PxVec2 resolution);
 
+    // Recreates the canvases if the multisampling level changes.
+    void set_antialiasing(AntiAliasing antialiasing);
+
     bool load(const std::string& level_path, const std::string& save_path = "");
     bool save(const std::string& save_path) const;
 
-    void render(sf::RenderTarget& target);
+    // Records the state that rendering interpolates from; call before each simulation step.
+    void save_interpolation_state();
+
+    // Interpolation is the progress [0-1] from the state before the latest simulation step,
+    // towards the current one; i.e. how far rendering is between two steps.
+    void render(sf::RenderTarget& target, float interpolation = 1.f);
 
     const MenuBarData& get_menu_bar_data() const;
 
@@ -117,6 +129,11 @@ public:
 
     bool has_level_loaded() const;
 
+    // Returns true if nothing in the level changes over time, until there is input;
+    // i.e. all objects are idle, and so are the camera, crosshair, light and particles.
+    // See Light::is_idle() for count_light_swing.
+    bool is_idle(bool count_light_swing = true) const;
+
     void initialize_debug_components();
     void toggle_debug_mode();
 
@@ -158,14 +175,17 @@ private:
 
     void scale_and_position_overlays();
 
+    void create_canvases();
+
     void insert_user_list_into_menu_level();
 
     void on_event(Event event, const Data& data) override;
 
     // Expects a map that may include:
-    // ======================================
+    // ==============================================
     // * bar:         <MenuBarData>
     // * audio:       <AudioData>
+    // * textures:    map<std::string, MipmapPolicy>
     // * table:       <Table>
     // * light:       <Light>
     // * camera:      <Camera>
@@ -173,8 +193,10 @@ private:
     // * objects:     map<ID, Object>
     // * tlc_overlay: <std::string>
     // * brc_overlay: <std::string>
-    // ======================================
+    // ==============================================
     // All components will have some default value if unspecified.
+    // Texture policies: [none, generate, precomputed] (generate by default);
+    // they are kept by the TextureManager, so they also apply to other levels using the texture.
     bool initialize(const YAML::Node& root_node) override;
 
     // Returns a map that consists of:
@@ -197,6 +219,7 @@ private:
     std::unordered_map<ID, Objective> objectives;
 
     tsl::ordered_map<ID, std::shared_ptr<Object>> objects;
+    ActiveSet active_objects;
 
     std::shared_ptr<Object> active_object;
     std::shared_ptr<Object> hovered_object;
@@ -233,6 +256,7 @@ private:
     sf::RenderTexture base_canvas;
     sf::RenderTexture final_canvas;
     sf::Sprite        final_sprite;
+    AntiAliasing      antialiasing;
 
     std::string loaded_level_path;
     bool level_loaded;
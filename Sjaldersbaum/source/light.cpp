@@ -1,14 +1,35 @@
 #include "light.h"
 
+#include <fstream>
+#include <sstream>
+
 #include "logger.h"
 #include "convert.h"
 #include "maths.h"
 #include "colors.h"
+#include "file_watcher.h"
 
 /*------------------------------------------------------------------------------------------------*/
 
 const sf::Color DEBUG_LINES_COLOR = Colors::MAGENTA;
 
+// Shared by all light shaders; provides the 'fxaa' uniform and sample_canvas().
+const std::string FXAA_SHADER_PATH = "resources/shaders/fxaa.glsl";
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool read_shader_source(const std::string& path, std::string& source)
+{
+    std::ifstream file{ path };
+    if (!file)
+        return false;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    source = buffer.str();
+    return true;
+}
+
 /*------------------------------------------------------------------------------------------------*/
 // Ellipse:
 
@@ -54,6 +75,7 @@ constexpr Seconds RADIUS_BOOST_DURATION = 0.2f;
 constexpr Seconds RADIUS_DECAY_DURATION = 10.f;
 
 Light::Light() :
+    fxaa              { false },
     on_sound          { UNINITIALIZED_SOUND },
     off_sound         { UNINITIALIZED_SOUND },
     source            { { 0.f, 0.f } },
@@ -64,7 +86,9 @@ Light::Light() :
     base_radius       { 0.f },
     base_brightness   { 0.f },
     inner_orbit_angle { 0.f },
-    source_angle      { 0.f }
+    source_angle      { 0.f },
+    swing_paused      { false },
+    previous_state    { { 0.f, 0.f }, { 0.f, 0.f }, 0.f, 0.f }
 {
 
 }
@@ -88,13 +112,22 @@ void Light::update(const Seconds elapsed_time)
         outer_orbit.semi_minor_axis = outer_orbit_radius.get_current();
     }
 
-    update_inner_orbit_size_and_angle(elapsed_time);
-    update_source_angle(elapsed_time);
+    if (!swing_paused)
+    {
+        update_inner_orbit_size_and_angle(elapsed_time);
+        update_source_angle(elapsed_time);
+    }
+}
+
+void Light::save_interpolation_state()
+{
+    previous_state = get_state();
 }
 
 void Light::apply(const sf::RenderTexture& source_canvas,
                   sf::RenderTexture& target_canvas,
-                  const sf::View& view) const
+                  const sf::View& view,
+                  const float interpolation) const
 {
     sf::RenderStates local_states;
     local_states.shader = &shader;
@@ -105,12 +138,14 @@ void Light::apply(const sf::RenderTexture& source_canvas,
     const float zoom = canvas_size.x / view.getSize().x;
 
     // Local uniforms:
-    Px     radius     = this->radius.get_current();
-    float  brightness = this->brightness.get_current();
-    PxVec2 point      = inner_orbit.get_point(source_angle);
+    const State state = get_state();
+    Px     radius     = blend(previous_state.radius,     state.radius,     interpolation);
+    float  brightness = blend(previous_state.brightness, state.brightness, interpolation);
+    PxVec2 point      = blend(previous_state.point,      state.point,      interpolation);
+    PxVec2 center     = blend(previous_state.center,     state.center,     interpolation);
 
     // Blur light (apply "height") based on distance from source:
-    Px point_distance = get_distance(inner_orbit.center, point);
+    Px point_distance = get_distance(center, point);
     radius += point_distance / 2.2f;
     brightness -= pow(point_distance, 0.3f) / 100.f;
 
@@ -129,15 +164,62 @@ void Light::apply(const sf::RenderTexture& source_canvas,
     target_canvas.display();
 }
 
+Light::State Light::get_state() const
+{
+    return { inner_orbit.center,
+             inner_orbit.get_point(source_angle),
+             radius.get_current(),
+             brightness.get_current() };
+}
+
 void Light::set_shader(const std::string& path)
 {
     shader_path = path;
 
-    if (!shader.loadFromFile(shader_path, sf::Shader::Fragment))
-        LOG_ALERT("light shader could not be loaded from: " + shader_path);
+    std::string shared_source;
+    std::string source;
+    if (!read_shader_source(FXAA_SHADER_PATH, shared_source))
+        LOG_ALERT("shared light shader source could not be read from: " + FXAA_SHADER_PATH);
+    else if (!read_shader_source(shader_path, source))
+        LOG_ALERT("light shader could not be read from: " + shader_path);
+    else
+    {
+        // The shared source goes after a #version directive, which has to come first:
+        const size_t insertion = source.starts_with("#version") ? source.find('\n') + 1 : 0u;
+        source.insert(insertion, shared_source);
+
+        if (!shader.loadFromMemory(source, sf::Shader::Fragment))
+            LOG_ALERT("light shader could not be loaded from: " + shader_path);
+        else if (fxaa)
+            shader.setUniform("fxaa", true);
+    }
+
+    FileWatcher::instance().watch(FXAA_SHADER_PATH);
+    FileWatcher::instance().watch(shader_path);
+}
+
+bool Light::is_shader_source(const std::string& path) const
+{
+    return path == shader_path || path == FXAA_SHADER_PATH;
+}
+
+const std::string& Light::get_shader_path() const
+{
+    return shader_path;
+}
+
+void Light::set_fxaa(const bool enable)
+{
+    // Only touch the uniform when FXAA is (or was) in use;
+    // shaders that never call sample_canvas() lose it during compilation, producing a warning.
+    if (enable == fxaa)
+        return;
+
+    fxaa = enable;
+    shader.setUniform("fxaa", fxaa);
 }
 
-void Light::set_radius(Px radius, Seconds progression_duration)
+void Light::set_radius(Px radius, Seconds progression_duration, const Easing easing)
 {
     if (!assure_bounds(radius, 0.f, PX_LIMIT))
         LOG_ALERT("invalid radius had to be adjusted.");
@@ -149,11 +231,12 @@ void Light::set_radius(Px radius, Seconds progression_duration)
     if (on)
     {
         this->radius.set_progression_duration(progression_duration);
+        this->radius.set_easing(easing);
         this->radius.set_target(radius);
     }
 }
 
-void Light::set_source(PxVec2 source, Seconds progression_duration)
+void Light::set_source(PxVec2 source, Seconds progression_duration, const Easing easing)
 {
     if (!(assure_bounds(source.x, -PX_LIMIT, PX_LIMIT) &
           assure_bounds(source.y, -PX_LIMIT, PX_LIMIT)))
@@ -163,10 +246,11 @@ void Light::set_source(PxVec2 source, Seconds progression_duration)
         LOG_ALERT("invalid progression_duration had to be adjusted; [0-3600]");
 
     this->source.set_progression_duration(progression_duration);
+    this->source.set_easing(easing);
     this->source.set_target(source);
 }
 
-void Light::set_brightness(float brightness, Seconds progression_duration)
+void Light::set_brightness(float brightness, Seconds progression_duration, const Easing easing)
 {
     if (!assure_bounds(brightness, 0.f, 100.f))
         LOG_ALERT("invalid brightness had to be adjusted. [0-100]");
@@ -178,11 +262,12 @@ void Light::set_brightness(float brightness, Seconds progression_duration)
     if (on)
     {
         this->brightness.set_progression_duration(progression_duration);
+        this->brightness.set_easing(easing);
         this->brightness.set_target(brightness);
     }
 }
 
-void Light::set_swing(Px radius, Seconds progression_duration)
+void Light::set_swing(Px radius, Seconds progression_duration, const Easing easing)
 {
     if (!assure_bounds(radius, 0.f, PX_LIMIT))
         LOG_ALERT("invalid swing radius had to be adjusted.");
@@ -191,6 +276,7 @@ void Light::set_swing(Px radius, Seconds progression_duration)
         LOG_ALERT("invalid progression_duration had to be adjusted; [0-3600]");
 
     outer_orbit_radius.set_progression_duration(progression_duration);
+    outer_orbit_radius.set_easing(easing);
     outer_orbit_radius.set_target(radius);
 }
 
@@ -200,6 +286,8 @@ void Light::set_on(const bool on, const Seconds transition_duration, const bool
         return;
 
     brightness.set_progression_duration(transition_duration);
+    brightness.set_easing(Easing::Linear);
+    radius.set_easing(Easing::Linear);
 
     if (on)
     {
@@ -220,6 +308,22 @@ void Light::set_on(const bool on, const Seconds transition_duration, const bool
     this->on = on;
 }
 
+void Light::set_swing_paused(const bool paused)
+{
+    swing_paused = paused;
+}
+
+bool Light::is_idle(const bool count_swing) const
+{
+    if (source.is_progressing() || radius.is_progressing() || brightness.is_progressing() ||
+        outer_orbit_radius.is_progressing())
+        return false;
+
+    const bool swinging = outer_orbit_radius.get_current() > 0.f && radius.get_current() > 0.f;
+
+    return !(count_swing && swinging);
+}
+
 void Light::render_debug_lines(sf::RenderTarget& target) const
 {
     inner_orbit.render(target);
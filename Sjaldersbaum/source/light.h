@@ -38,28 +38,50 @@ public:
 
     void update(Seconds elapsed_time);
 
+    // Records the light as it is before a simulation step; see apply().
+    void save_interpolation_state();
+
     // Draws the content of source_canvas to target_canvas, applying the shader.
     // Since the content of the canvas is no longer in table-coordinates, but the Light always is,
     // the ("table") view is required to also translate the Light.
+    // The light is rendered between its state before the latest step (0) and its current state (1).
     void apply(const sf::RenderTexture& source_canvas,
                sf::RenderTexture& target_canvas,
-               const sf::View& view) const;
+               const sf::View& view,
+               float interpolation = 1.f) const;
 
     void set_shader(const std::string& path);
 
-    void set_radius(Px radius, Seconds progression_duration = 0.f);
+    const std::string& get_shader_path() const;
+
+    // Returns true if the shader is built from the file at path;
+    // i.e. its own source, or the shared source that is prepended to every light shader.
+    bool is_shader_source(const std::string& path) const;
+
+    // Enables a cheap edge-smoothing pass (FXAA) within the light shader.
+    // Shaders only apply it if they sample the canvas through sample_canvas() (see fxaa.glsl).
+    void set_fxaa(bool enable);
+
+    void set_radius(Px radius, Seconds progression_duration = 0.f, Easing easing = Easing::Linear);
 
-    void set_source(PxVec2 source, Seconds progression_duration = 0.f);
+    void set_source(PxVec2 source, Seconds progression_duration = 0.f, Easing easing = Easing::Linear);
 
-    void set_brightness(float brightness, Seconds progression_duration = 0.f);
+    void set_brightness(float brightness, Seconds progression_duration = 0.f, Easing easing = Easing::Linear);
 
     // Sets the maximum radius (semi major axis) of the orbit around which the light swings.
     // Set to 0 for a static light.
-    void set_swing(Px radius, Seconds progression_duration = 0.f);
+    void set_swing(Px radius, Seconds progression_duration = 0.f, Easing easing = Easing::Linear);
 
     // Note that the Light is "off" by default.
     void set_on(bool on, Seconds transition_duration, bool sound = true);
 
+    // A paused swing holds the source where it is; used while the app idles.
+    void set_swing_paused(bool paused);
+
+    // Returns true if the shader's uniforms do not change over time.
+    // A swinging (visible) light is only considered idle if count_swing is false.
+    bool is_idle(bool count_swing = true) const;
+
     // Draws the light's source (a point representing it) and its orbit.
     void render_debug_lines(sf::RenderTarget& target) const;
 
@@ -85,6 +107,16 @@ public:
     YAML::Node serialize_dynamic_data() const override;
 
 private:
+    // What the shader's uniforms are derived from.
+    struct State
+    {
+        PxVec2 center;
+        PxVec2 point;
+        Px     radius;
+        float  brightness;
+    };
+    State get_state() const;
+
     void update_inner_orbit_size_and_angle(Seconds elapsed_time);
 
     void update_source_angle(Seconds elapsed_time);
@@ -92,6 +124,7 @@ private:
 private:
     mutable sf::Shader shader;
     std::string shader_path;
+    bool fxaa;
 
     SoundID on_sound;
     SoundID off_sound;
@@ -113,4 +146,7 @@ private:
     Ellipse inner_orbit;
     Degree  inner_orbit_angle;
     Degree source_angle;
+    bool   swing_paused;
+
+    State previous_state;
 };
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "logger.h"
 
-#include <fstream>
 #include <iostream>
+#include <utility>
+#include <chrono>
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -11,35 +12,180 @@ bool RESOURCE_LOGGING = false;
 
 const std::string LOG_PATH = "latest_log.txt";
 
+// Messages beyond this many (not yet flushed) are dropped:
+constexpr size_t RING_CAPACITY = 4096u;
+
+// How often the log file is brought up to date:
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(100);
+
+// Input that DebugWindow has not extracted; older input is discarded beyond this length.
+constexpr size_t MAX_NEW_INPUT_LENGTH = 256u * 1024u;
+
+/*------------------------------------------------------------------------------------------------*/
+
+MessageRing::MessageRing(const size_t capacity) :
+    cells{ std::make_unique<Cell[]>(capacity) },
+    mask{ capacity - 1u },
+    push_position{ 0u },
+    pop_position{ 0u }
+{
+    for (size_t i = 0u; i < capacity; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool MessageRing::try_push(std::string& message)
+{
+    size_t position = push_position.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell = cells[position & mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            // The cell is free; claim it:
+            if (push_position.compare_exchange_weak(position, position + 1u,
+                                                    std::memory_order_relaxed))
+            {
+                cell.message = std::move(message);
+                cell.sequence.store(position + 1u, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+            return false; // The consumer has yet to pop the cell a whole lap ago.
+        else
+            position = push_position.load(std::memory_order_relaxed);
+    }
+}
+
+bool MessageRing::try_pop(std::string& message)
+{
+    Cell& cell = cells[pop_position & mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != pop_position + 1u)
+        return false; // Not (completely) pushed yet.
+
+    message = std::move(cell.message);
+    cell.message = std::string();
+    cell.sequence.store(pop_position + mask + 1u, std::memory_order_release);
+    ++pop_position;
+    return true;
+}
+
 /*------------------------------------------------------------------------------------------------*/
 
-Logger::Logger()
+Logger::StreamRedirection::StreamRedirection(Logger& logger) :
+    logger{ logger }
+{
+
+}
+
+Logger::StreamRedirection::int_type Logger::StreamRedirection::overflow(const int_type ch)
 {
-    // Redirect std::cout/cerr to the local buffer:
-    std::cout.rdbuf(new_input.rdbuf());
-    std::cerr.rdbuf(new_input.rdbuf());
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+
+    std::lock_guard lock{ mutex };
+    line += traits_type::to_char_type(ch);
+    if (line.back() == '\n')
+    {
+        logger.write(std::move(line));
+        line.clear();
+    }
+    return ch;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+Logger::Logger() :
+    ring{ RING_CAPACITY },
+    dropped_count{ 0u },
+    level{ LogLevel::Debug },
+    file{ LOG_PATH, std::ios_base::out | std::ios_base::trunc },
+    stopping{ false },
+    stream_redirection{ *this }
+{
+    // Redirect std::cout/cerr to the log:
+    original_cout = std::cout.rdbuf(&stream_redirection);
+    original_cerr = std::cerr.rdbuf(&stream_redirection);
+
+    flusher = std::thread{ &Logger::flush_continuously, this };
 }
 
 Logger::~Logger()
 {
-    std::ofstream file;
-    file.open(LOG_PATH, std::ios_base::out | std::ios_base::trunc);
-    if (file)
-        file << input.str();
+    std::cout.rdbuf(original_cout);
+    std::cerr.rdbuf(original_cerr);
+
+    {
+        std::lock_guard lock{ flusher_mutex };
+        stopping = true;
+    }
+    flusher_condition.notify_one();
+    flusher.join();
 }
 
 void Logger::write(std::string&& str)
 {
-    new_input << str;
-    input     << str;
+    if (!ring.try_push(str))
+        dropped_count.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void Logger::set_level(const LogLevel level)
+{
+    this->level.store(level, std::memory_order_relaxed);
+}
+
+bool Logger::is_enabled(const LogLevel level) const
+{
+    return level >= this->level.load(std::memory_order_relaxed) && level != LogLevel::Off;
 }
 
 std::string Logger::extract_new_input()
 {
-    const std::string str = new_input.str();
+    std::lock_guard lock{ new_input_mutex };
+    return std::exchange(new_input, std::string());
+}
 
-    new_input.str(std::string());
-    new_input.clear();
+void Logger::flush_continuously()
+{
+    std::unique_lock lock{ flusher_mutex };
+    while (!stopping)
+    {
+        flusher_condition.wait_for(lock, FLUSH_INTERVAL);
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+
+    // Whatever was written right before the end:
+    flush();
+}
+
+void Logger::flush()
+{
+    std::string flushed;
+    for (std::string message; ring.try_pop(message);)
+        flushed += message;
 
-    return str;
-}
\ No newline at end of file
+    const size_t dropped = dropped_count.exchange(0u, std::memory_order_relaxed);
+    if (dropped != 0u)
+        flushed += "\n" + std::to_string(dropped) + " messages were dropped; too many at once.\n";
+
+    if (flushed.empty())
+        return;
+
+    if (file)
+    {
+        file << flushed;
+        file.flush();
+    }
+
+    std::lock_guard lock{ new_input_mutex };
+    new_input += flushed;
+    if (new_input.length() > MAX_NEW_INPUT_LENGTH)
+        new_input.erase(0u, new_input.length() - MAX_NEW_INPUT_LENGTH);
+}
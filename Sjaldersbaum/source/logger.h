@@ -1,27 +1,110 @@
 #pragma once
 
 #include <string>
-#include <sstream>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <streambuf>
+#include <condition_variable>
 
 /*------------------------------------------------------------------------------------------------*/
 
-#define LOG(str) Logger::instance().write(std::string("\n") + str + "\n")
+// Messages below this level are not logged; and their arguments are not even formatted.
+enum class LogLevel
+{
+    Debug,  // e.g. resource logging
+    Intel,
+    Alert,
+    Off
+};
+
+// Calls below this level are stripped from the build entirely.
+// Can be overridden by defining SJ_MIN_LOG_LEVEL (as the integer value of a LogLevel).
+#ifndef SJ_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define SJ_MIN_LOG_LEVEL 1
+#else
+#define SJ_MIN_LOG_LEVEL 0
+#endif
+#endif
+
+constexpr LogLevel MIN_LOG_LEVEL = static_cast<LogLevel>(SJ_MIN_LOG_LEVEL);
+
+// The message is only evaluated if level is enabled, both at compile-time and at runtime:
+#define LOG_AT(level, str)                                \
+do                                                        \
+{                                                         \
+    if constexpr ((level) >= MIN_LOG_LEVEL)               \
+        if (Logger::instance().is_enabled(level))         \
+            Logger::instance().write(str);                \
+} while (false)
 
-#define LOG_INTEL(info)   \
-Logger::instance().write( \
-    std::string(          \
+#define LOG(str) LOG_AT(LogLevel::Intel, std::string("\n") + str + "\n")
+
+#define LOG_DEBUG(info)                                                                  \
+LOG_AT(LogLevel::Debug,                                                                  \
+    std::string(                                                                         \
+        "\n......................................................................\n") + \
+        '<' + __FUNCTION__ + ">\n" + info + '\n')
+
+#define LOG_INTEL(info)                                                                  \
+LOG_AT(LogLevel::Intel,                                                                  \
+    std::string(                                                                         \
         "\n----------------------------------------------------------------------\n") + \
         '<' + __FUNCTION__ + ">\n" + info + '\n')
 
-#define LOG_ALERT(warning) \
-Logger::instance().write(  \
-    std::string(           \
+#define LOG_ALERT(warning)                                                               \
+LOG_AT(LogLevel::Alert,                                                                  \
+    std::string(                                                                         \
         "\n######################################################################\n") + \
         '<' + __FUNCTION__ + ">\n" + warning + '\n')
 
+// For alerts that may otherwise repeat every frame; only the first occurrence is logged.
+#define LOG_ALERT_ONCE(warning)                                                          \
+do                                                                                       \
+{                                                                                        \
+    static std::atomic_flag logged;                                                      \
+    if (!logged.test_and_set())                                                          \
+        LOG_ALERT(warning + std::string("\n(further occurrences are not logged)"));      \
+} while (false)
+
 /*------------------------------------------------------------------------------------------------*/
 
-// Interface to a std::stringstream, which's content automatically saves to a file upon its death.
+// Lock-free queue of log messages with a fixed capacity; any thread may push, one thread pops.
+// Implementation detail for Logger.
+class MessageRing
+{
+public:
+    MessageRing(size_t capacity); // Capacity must be a power of 2.
+
+    // Returns false if the ring is full; the message is then left untouched.
+    bool try_push(std::string& message);
+
+    // Consumer only. Returns false if the ring is empty.
+    bool try_pop(std::string& message);
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence; // Tells whether the cell is free, or holds a message.
+        std::string message;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    const size_t mask;
+
+    alignas(64) std::atomic<size_t> push_position;
+    alignas(64) size_t pop_position;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Collects messages (and whatever is written to std::cout/cerr) from any thread into a ring buffer,
+// which a background thread regularly flushes to the log file; so the file is up to date even if
+// the app crashes, and memory use stays bounded no matter how long it runs.
+// If the ring overflows (a burst of messages), messages are dropped and the drop is logged.
 class Logger
 {
 public:
@@ -33,12 +116,50 @@ public:
 
     void write(std::string&& str);
 
-    // Specifically for DebugWindow.
+    // Sets the lowest level that is logged (LogLevel::Debug by default); see also MIN_LOG_LEVEL.
+    void set_level(LogLevel level);
+    bool is_enabled(LogLevel level) const;
+
+    // Specifically for DebugWindow. Only recent input is kept, if it is not extracted regularly.
     std::string extract_new_input();
 
 private:
-    std::stringstream input;
-    std::stringstream new_input;
+    void flush_continuously();
+
+    // Moves the messages from the ring into the file and into new_input. Flusher thread only.
+    void flush();
+
+private:
+    MessageRing ring;
+    std::atomic<size_t> dropped_count;
+    std::atomic<LogLevel> level;
+
+    std::ofstream file;
+
+    std::string new_input;
+    std::mutex new_input_mutex;
+
+    std::thread flusher;
+    std::mutex flusher_mutex;
+    std::condition_variable flusher_condition;
+    bool stopping;
+
+    // Forwards std::cout/cerr to write(), line by line.
+    class StreamRedirection : public std::streambuf
+    {
+    public:
+        StreamRedirection(Logger& logger);
+
+    private:
+        int_type overflow(int_type ch) override;
+
+        Logger& logger;
+        std::string line;
+        std::mutex mutex;
+    };
+    StreamRedirection stream_redirection;
+    std::streambuf* original_cout;
+    std::streambuf* original_cerr;
 
 private:
     Logger();
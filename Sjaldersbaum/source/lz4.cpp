@@ -0,0 +1,175 @@
+#include "lz4.h"
+
+#include <cstring>
+
+/*------------------------------------------------------------------------------------------------*/
+
+constexpr std::size_t MIN_MATCH     = 4;
+constexpr std::size_t LAST_LITERALS = 5;     // The last bytes of a block are always literals.
+constexpr std::size_t MATCH_LIMIT   = 12;    // Matches must start this far from the end.
+constexpr std::size_t MAX_DISTANCE  = 65535; // Offsets are stored in 2 bytes.
+constexpr int         HASH_LOG      = 16;
+constexpr int         SKIP_TRIGGER  = 6;     // Speeds up the search through incompressible data.
+
+/*------------------------------------------------------------------------------------------------*/
+
+std::uint32_t read_u32(const std::uint8_t* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::uint32_t hash_sequence(const std::uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HASH_LOG);
+}
+
+// Lengths >= 15 continue in extra bytes: a run of 255s followed by the remainder.
+void write_length(std::vector<std::uint8_t>& dst, std::size_t length)
+{
+    for (; length >= 255u; length -= 255u)
+        dst.push_back(255u);
+    dst.push_back(static_cast<std::uint8_t>(length));
+}
+
+void write_sequence(std::vector<std::uint8_t>& dst,
+                    const std::uint8_t* literals, const std::size_t literal_count,
+                    const std::size_t offset,     const std::size_t match_length)
+{
+    const std::size_t literal_nibble = literal_count < 15u ? literal_count : 15u;
+    const std::size_t match_nibble   = match_length == 0u ? 0u :
+                                       (match_length - MIN_MATCH < 15u ? match_length - MIN_MATCH : 15u);
+
+    dst.push_back(static_cast<std::uint8_t>((literal_nibble << 4) | match_nibble));
+    if (literal_nibble == 15u)
+        write_length(dst, literal_count - 15u);
+
+    dst.insert(dst.end(), literals, literals + literal_count);
+
+    // The last sequence consists of literals only:
+    if (match_length == 0u)
+        return;
+
+    dst.push_back(static_cast<std::uint8_t>(offset & 0xFFu));
+    dst.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (match_nibble == 15u)
+        write_length(dst, match_length - MIN_MATCH - 15u);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace LZ4
+{
+std::vector<std::uint8_t> compress(const std::uint8_t* const src, const std::size_t src_size)
+{
+    std::vector<std::uint8_t> dst;
+    dst.reserve(src_size + src_size / 255u + 16u);
+
+    std::size_t anchor = 0u;
+
+    if (src_size > MATCH_LIMIT)
+    {
+        std::vector<std::uint32_t> table(std::size_t{ 1 } << HASH_LOG, 0u);
+
+        const std::size_t match_start_limit = src_size - MATCH_LIMIT;
+        const std::size_t match_end_limit   = src_size - LAST_LITERALS;
+
+        std::size_t position = 0u;
+        while (position < match_start_limit)
+        {
+            const std::uint32_t sequence  = read_u32(src + position);
+            const std::uint32_t hash      = hash_sequence(sequence);
+            const std::size_t   candidate = table[hash];
+            table[hash] = static_cast<std::uint32_t>(position);
+
+            if (candidate >= position || position - candidate > MAX_DISTANCE ||
+                read_u32(src + candidate) != sequence)
+            {
+                position += 1u + ((position - anchor) >> SKIP_TRIGGER);
+                continue;
+            }
+
+            std::size_t match_length = MIN_MATCH;
+            while (position + match_length < match_end_limit &&
+                   src[candidate + match_length] == src[position + match_length])
+                ++match_length;
+
+            write_sequence(dst, src + anchor, position - anchor, position - candidate, match_length);
+
+            position += match_length;
+            anchor = position;
+        }
+    }
+
+    write_sequence(dst, src + anchor, src_size - anchor, 0u, 0u);
+    return dst;
+}
+
+bool decompress(const std::uint8_t* const src, const std::size_t src_size,
+                std::uint8_t* const dst,       const std::size_t dst_size)
+{
+    std::size_t in  = 0u;
+    std::size_t out = 0u;
+
+    // Reads a length continued in extra bytes; returns false if the block ends prematurely.
+    const auto read_length = [&](std::size_t& length) -> bool
+    {
+        std::uint8_t byte;
+        do
+        {
+            if (in >= src_size)
+                return false;
+            byte = src[in++];
+            length += byte;
+        } while (byte == 255u);
+        return true;
+    };
+
+    while (in < src_size)
+    {
+        const std::uint8_t token = src[in++];
+
+        std::size_t literal_count = token >> 4;
+        if (literal_count == 15u && !read_length(literal_count))
+            return false;
+
+        if (literal_count > src_size - in || literal_count > dst_size - out)
+            return false;
+        std::memcpy(dst + out, src + in, literal_count);
+        in  += literal_count;
+        out += literal_count;
+
+        // The last sequence has no match:
+        if (in == src_size)
+            break;
+
+        if (src_size - in < 2u)
+            return false;
+        const std::size_t offset = src[in] | (static_cast<std::size_t>(src[in + 1]) << 8);
+        in += 2u;
+
+        if (offset == 0u || offset > out)
+            return false;
+
+        std::size_t match_length = token & 0x0Fu;
+        if (match_length == 15u && !read_length(match_length))
+            return false;
+        match_length += MIN_MATCH;
+
+        if (match_length > dst_size - out)
+            return false;
+
+        // Matches may overlap with the bytes they produce (e.g. runs), so copy forwards:
+        const std::uint8_t* match = dst + out - offset;
+        if (offset >= match_length)
+            std::memcpy(dst + out, match, match_length);
+        else
+            for (std::size_t i = 0u; i < match_length; ++i)
+                dst[out + i] = match[i];
+        out += match_length;
+    }
+
+    return out == dst_size;
+}
+}
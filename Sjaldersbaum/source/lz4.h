@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Minimal implementation of the LZ4 block format: fast, byte-oriented LZ77 without entropy coding.
+// Used for caches, where decompression speed matters far more than the compression ratio.
+namespace LZ4
+{
+// Returns src compressed into a single LZ4 block.
+std::vector<std::uint8_t> compress(const std::uint8_t* src, std::size_t src_size);
+
+// Decompresses an LZ4 block into dst, which must be exactly as large as the original data.
+// Returns false if the block is malformed or does not decompress to exactly dst_size bytes.
+bool decompress(const std::uint8_t* src, std::size_t src_size,
+                std::uint8_t* dst,       std::size_t dst_size);
+}
@@ -1,10 +1,12 @@
 ﻿#include <random>
 
 #include "app.h"
+#include "archive.h"
 
 extern const std::string SYSTEM_FONT_PATH = "resources/fonts/fira_medium.ttf";
 
-extern const Seconds RESOURCE_DESTRUCTION_INTERVAL = 120.f;
+// Optional; if present, resources are read from it instead of from loose files.
+const std::string ARCHIVE_PATH = "resources.pak";
 
 extern std::mt19937 GLOBAL_MT = std::mt19937{};
 
@@ -20,10 +22,13 @@ int main()
 {
     // Assure logger gets destructed very last:
     Logger::instance();
+    // Assure the archive, whose memory resources may be loaded from, outlives them:
+    Archive::instance().mount(ARCHIVE_PATH);
     // Assure all the resources, which other singletons may reference, die second-last:
     TextureManager::instance();
     SoundBufferManager::instance();
     FontManager::instance();
+    ImageManager::instance();
 
     srand(static_cast<unsigned int>(time(nullptr)));
     std::random_device rd;
@@ -78,6 +78,7 @@ MenuBar::MenuBar() :
     text_props.outline = Colors::BLACK;
     text_props.outline_thickness = 3.f;
     max_text_height = text_props.get_max_height();
+    text_props.prewarm(); // Rasterized along with the first level.
 
     std::vector<sf::Text*> texts{ &user_id, &action_description, &time_display, &message };
     for (auto text : texts)
@@ -244,6 +245,12 @@ void MenuBar::set_width(const Px width)
     position_objects();
 }
 
+bool MenuBar::is_idle() const
+{
+    return !position.is_progressing() && !opacity.is_progressing() && !message_mode &&
+           inactivity_lag >= AUTO_HIDE_INTERVAL && action_progress <= -ACTION_DELAY;
+}
+
 void MenuBar::position_objects()
 {
     static constexpr Px m = 10.f;
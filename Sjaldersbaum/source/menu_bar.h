@@ -41,6 +41,9 @@ public:
 
     void set_width(Px width);
 
+    // Returns true if the bar is hidden and has nothing to show or animate.
+    bool is_idle() const;
+
 private:
     void position_objects();
 
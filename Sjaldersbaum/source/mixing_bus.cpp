@@ -0,0 +1,251 @@
+#include "mixing_bus.h"
+
+#include <algorithm>
+
+/*------------------------------------------------------------------------------------------------*/
+
+constexpr unsigned int OUTPUT_SAMPLE_RATE   = 44100u;
+constexpr unsigned int OUTPUT_CHANNEL_COUNT = 2u;
+
+// ~12ms per chunk; SFML queues a few chunks ahead, so latency stays well below a frame or three.
+constexpr size_t CHUNK_FRAMES  = 512u;
+constexpr size_t CHUNK_SAMPLES = CHUNK_FRAMES * OUTPUT_CHANNEL_COUNT;
+
+// Far more than any per-sound limit allows in practice; slots cost no OpenAL sources.
+constexpr size_t SLOT_COUNT = 256u;
+
+constexpr std::uint32_t FIXED_ONE = 1u << 16;
+
+// Gain of other sounds while a SoundPriority::High sound plays, and how fast it changes:
+constexpr float DUCKING_GAIN       = 0.4f;
+constexpr float DUCKING_GAIN_STEP  = 0.1f; // Per chunk; i.e. fully ducked after ~70ms.
+
+/*------------------------------------------------------------------------------------------------*/
+
+MixingBus::MixingBus() :
+    slots(SLOT_COUNT),
+    mix_count{ 0u },
+    target_gain{ 0.f },
+    ducked_mix(CHUNK_SAMPLES),
+    dry_mix(CHUNK_SAMPLES),
+    output(CHUNK_SAMPLES),
+    gain{ 0.f },
+    ducking_gain{ 1.f }
+{
+    initialize(OUTPUT_CHANNEL_COUNT, OUTPUT_SAMPLE_RATE);
+}
+
+MixingBus::~MixingBus()
+{
+    // The streaming thread must be done before the members it uses are destructed:
+    sf::SoundStream::stop();
+}
+
+void MixingBus::mix(const SoundBufferReference& buffer, const float loudness,
+                    const SoundID id, const SoundPriority priority, const int max_instances)
+{
+    const sf::SoundBuffer& sound_buffer = buffer.get();
+    const unsigned int channel_count = sound_buffer.getChannelCount();
+
+    if (sound_buffer.getSampleCount() == 0u)
+        return;
+    if (channel_count != 1u && channel_count != 2u)
+    {
+        LOG_ALERT("only mono and stereo sounds can be mixed:\n" + buffer.get_path());
+        return;
+    }
+
+    std::lock_guard lock{ mutex };
+
+    Slot* slot = acquire_slot(id, priority, max_instances);
+    if (!slot)
+        return;
+
+    slot->buffer        = buffer;
+    slot->samples       = sound_buffer.getSamples();
+    slot->frame_count   = static_cast<size_t>(sound_buffer.getSampleCount()) / channel_count;
+    slot->channel_count = channel_count;
+    slot->position      = 0u;
+    slot->step          = static_cast<std::uint32_t>(
+        (static_cast<std::uint64_t>(sound_buffer.getSampleRate()) << 16) / OUTPUT_SAMPLE_RATE);
+
+    slot->gain        = loudness;
+    slot->id          = id;
+    slot->priority    = priority;
+    slot->start_order = ++mix_count;
+    slot->active      = true;
+}
+
+void MixingBus::set_gain(const float gain)
+{
+    target_gain = std::clamp(gain, 0.f, 1.f);
+}
+
+void MixingBus::update()
+{
+    std::lock_guard lock{ mutex };
+
+    for (auto& slot : slots)
+        if (!slot.active && slot.buffer.is_loaded())
+            slot.buffer = SoundBufferReference{};
+}
+
+void MixingBus::stop_sounds(const std::string& path)
+{
+    std::lock_guard lock{ mutex };
+
+    for (auto& slot : slots)
+    {
+        if (slot.buffer.is_loaded() && (path.empty() || slot.buffer.get_path() == path))
+        {
+            slot.active = false;
+            slot.buffer = SoundBufferReference{};
+        }
+    }
+}
+
+MixingBus::Slot* MixingBus::acquire_slot(const SoundID id, const SoundPriority priority,
+                                         const int max_instances)
+{
+    Slot* free_slot       = nullptr;
+    Slot* oldest_instance = nullptr; // Oldest slot mixing the same sound.
+    Slot* weakest_slot    = nullptr; // Oldest slot of the lowest priority.
+    int instance_count = 0;
+
+    for (auto& slot : slots)
+    {
+        if (!slot.active)
+        {
+            if (!free_slot)
+                free_slot = &slot;
+            continue;
+        }
+
+        if (slot.id == id)
+        {
+            ++instance_count;
+            if (!oldest_instance || slot.start_order < oldest_instance->start_order)
+                oldest_instance = &slot;
+        }
+
+        if (!weakest_slot || slot.priority < weakest_slot->priority ||
+            (slot.priority == weakest_slot->priority && slot.start_order < weakest_slot->start_order))
+            weakest_slot = &slot;
+    }
+
+    if (instance_count >= max_instances)
+        return oldest_instance;
+
+    if (free_slot)
+        return free_slot;
+
+    if (weakest_slot && weakest_slot->priority <= priority)
+        return weakest_slot;
+
+    return nullptr;
+}
+
+void MixingBus::mix_slot(Slot& slot, float* const mix) const
+{
+    const size_t first_frame = static_cast<size_t>(slot.position >> 16);
+    const float  gain        = slot.gain;
+
+    if (slot.step == FIXED_ONE)
+    {
+        // Matching sample rates; plain loops the compiler can vectorize:
+        const size_t frame_count = std::min(CHUNK_FRAMES, slot.frame_count - first_frame);
+        const sf::Int16* const samples = slot.samples + first_frame * slot.channel_count;
+
+        if (slot.channel_count == 2u)
+            for (size_t i = 0u; i < frame_count * 2u; ++i)
+                mix[i] += samples[i] * gain;
+        else
+            for (size_t i = 0u; i < frame_count; ++i)
+            {
+                const float sample = samples[i] * gain;
+                mix[i * 2u]      += sample;
+                mix[i * 2u + 1u] += sample;
+            }
+
+        slot.position += static_cast<std::uint64_t>(frame_count) << 16;
+    }
+    else
+    {
+        // Other sample rates are converted on the fly (nearest sample; fine for short effects):
+        std::uint64_t position = slot.position;
+        for (size_t i = 0u; i < CHUNK_FRAMES; ++i, position += slot.step)
+        {
+            const size_t frame = static_cast<size_t>(position >> 16);
+            if (frame >= slot.frame_count)
+                break;
+
+            const sf::Int16* const samples = slot.samples + frame * slot.channel_count;
+            mix[i * 2u]      += samples[0] * gain;
+            mix[i * 2u + 1u] += samples[slot.channel_count - 1u] * gain;
+        }
+        slot.position = position;
+    }
+
+    if ((slot.position >> 16) >= slot.frame_count)
+        slot.active = false;
+}
+
+bool MixingBus::onGetData(Chunk& data)
+{
+    std::fill(ducked_mix.begin(), ducked_mix.end(), 0.f);
+    std::fill(dry_mix.begin(),    dry_mix.end(),    0.f);
+
+    bool ducking = false;
+    {
+        std::lock_guard lock{ mutex };
+
+        for (auto& slot : slots)
+        {
+            if (!slot.active)
+                continue;
+
+            if (slot.priority == SoundPriority::High)
+            {
+                ducking = true;
+                mix_slot(slot, dry_mix.data());
+            }
+            else
+                mix_slot(slot, ducked_mix.data());
+        }
+    }
+
+    // Gains are ramped across the chunk, so that changes never click:
+    const float start_gain = gain;
+    const float end_gain   = target_gain;
+
+    const float start_ducking_gain = ducking_gain;
+    const float end_ducking_gain   = ducking ?
+        std::max(ducking_gain - DUCKING_GAIN_STEP, DUCKING_GAIN) :
+        std::min(ducking_gain + DUCKING_GAIN_STEP, 1.f);
+
+    const float gain_delta         = (end_gain - start_gain) / CHUNK_FRAMES;
+    const float ducking_gain_delta = (end_ducking_gain - start_ducking_gain) / CHUNK_FRAMES;
+
+    for (size_t i = 0u; i < CHUNK_SAMPLES; ++i)
+    {
+        const float frame = static_cast<float>(i / OUTPUT_CHANNEL_COUNT);
+
+        const float sample = (ducked_mix[i] * (start_ducking_gain + ducking_gain_delta * frame) +
+                              dry_mix[i]) * (start_gain + gain_delta * frame);
+
+        output[i] = static_cast<sf::Int16>(std::clamp(sample, -32768.f, 32767.f));
+    }
+
+    gain         = end_gain;
+    ducking_gain = end_ducking_gain;
+
+    // The bus never ends; silence is streamed while no sound plays.
+    data.samples     = output.data();
+    data.sampleCount = output.size();
+    return true;
+}
+
+void MixingBus::onSeek(sf::Time)
+{
+    // Sounds are mixed as they come; there is nothing to seek.
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <SFML/Audio.hpp>
+
+#include "audio.h"
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Mixes short sounds in software into a single stream (one OpenAL source), instead of playing
+// each of them on a source of its own. Volume, fading and ducking are applied to the mixed
+// output, so they cost the same regardless of how many sounds overlap.
+// While a SoundPriority::High sound plays, all other sounds are ducked.
+class MixingBus : public sf::SoundStream
+{
+public:
+    MixingBus();
+    ~MixingBus();
+
+    // Starts mixing buffer into the output; follows the same rules as AudioPlayer::play().
+    void mix(const SoundBufferReference& buffer, float loudness,
+             SoundID id, SoundPriority priority, int max_instances);
+
+    // Sets the gain applied to the mixed output; [0-1]. Changes are ramped, so they never click.
+    void set_gain(float gain);
+
+    // Releases the buffers of sounds that have ended. Main thread only; call once per loop.
+    void update();
+
+    // Stops the sounds mixed from the buffer at path, or all sounds if path is empty.
+    // Must be called before such buffers are reloaded in place, since that frees their samples.
+    void stop_sounds(const std::string& path = "");
+
+private:
+    struct Slot
+    {
+        SoundBufferReference buffer; // Main thread only; keeps the samples alive.
+
+        const sf::Int16* samples = nullptr;
+        size_t frame_count = 0u;
+        unsigned int channel_count = 0u;
+        std::uint64_t position = 0u; // In source frames; 16.16 fixed point.
+        std::uint32_t step     = 0u; // Source frames per output frame; 16.16 fixed point.
+
+        float gain = 0.f;
+        SoundID id = 0u;
+        SoundPriority priority = SoundPriority::Low;
+        std::uint64_t start_order = 0u;
+        bool active = false;
+    };
+
+    // Returns a slot for a sound of id to be mixed on, or nullptr if there should be none.
+    // Expects mutex to be locked.
+    Slot* acquire_slot(SoundID id, SoundPriority priority, int max_instances);
+
+    // Adds the next chunk of slot to mix (interleaved stereo); deactivates slot once it ends.
+    void mix_slot(Slot& slot, float* mix) const;
+
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time time_offset) override;
+
+private:
+    std::vector<Slot> slots;
+    std::uint64_t mix_count;
+    std::mutex mutex;
+
+    std::atomic<float> target_gain;
+
+    // Streaming thread only:
+    std::vector<float> ducked_mix;
+    std::vector<float> dry_mix;
+    std::vector<sf::Int16> output;
+    float gain;
+    float ducking_gain;
+};
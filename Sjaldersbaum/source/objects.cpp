@@ -89,6 +89,7 @@ Sheet::Sheet(const bool independent) :
     pickup_sound { UNINITIALIZED_SOUND },
     release_sound{ UNINITIALIZED_SOUND },
     horizontal_flip{ false },
+    active_elements{ this },
     opacity{ 0.f }
 {
     if (!alpha_shader.loadFromFile(ALPHA_SHADER_PATH, sf::Shader::Type::Vertex))
@@ -124,15 +125,9 @@ void Sheet::update(const Seconds elapsed_time)
 
     highlight.update(elapsed_time);
 
-    bool all_elements_idle = true;
-    for (auto& [id, element] : elements)
-    {
-        element->update(elapsed_time);
-        if (!element->is_idle())
-            all_elements_idle = false;
-    }
+    active_elements.update(elapsed_time);
 
-    if (!opacity.is_progressing() && highlight.is_idle() && all_elements_idle &&
+    if (!opacity.is_progressing() && highlight.is_idle() && active_elements.is_empty() &&
         !this->is_active() && !this->is_hovered())
         this->set_idle(true);
 }
@@ -538,6 +533,7 @@ bool Sheet::on_initialization(const YAML::Node& node)
                 }
 
                 local_element_positions.emplace(id, round_hu(element->get_position()));
+                element->set_scheduler(&active_elements);
                 elements.emplace(std::move(id), std::move(element));
             }
         }
@@ -600,17 +596,23 @@ YAML::Node Sheet::on_dynamic_data_serialization() const
 
 void Sheet::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-    if (opacity.get_current() != 0.f)
-    {
-        if (opacity.get_current() != 1.f)
-            states.shader = &alpha_shader;
+    if (opacity.get_current() == 0.f)
+        return;
 
-        target.draw(highlight, states);
-        target.draw(background, states);
+    // Elements are positioned in table coordinates, as is the Sheet itself:
+    const PxRect visible_area = get_visible_area(target.getView());
+    if (!this->is_within(visible_area))
+        return;
 
-        for (const auto& [id, element] : elements)
+    if (opacity.get_current() != 1.f)
+        states.shader = &alpha_shader;
+
+    target.draw(highlight, states);
+    target.draw(background, states);
+
+    for (const auto& [id, element] : elements)
+        if (element->is_within(visible_area))
             target.draw(*element, states);
-    }
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -619,6 +621,7 @@ void Sheet::draw(sf::RenderTarget& target, sf::RenderStates states) const
 constexpr Seconds SHEET_TURN_COOLDOWN = 0.4f;
 
 Binder::Binder() : Object(EntityConfigs::BINDER, Object::Type::Binder),
+    active_sheets{ this },
     sheet_turn_cooldown{ 0.f }
 {
 
@@ -641,11 +644,9 @@ void Binder::update(const Seconds elapsed_time)
 {
     sheet_turn_cooldown -= elapsed_time;
 
-    for (auto& [id, sheet] : sheets)
-        if (sheet == active_sheet || !sheet->is_idle())
-            sheet->update(elapsed_time);
+    active_sheets.update(elapsed_time);
 
-    if (active_sheet->is_idle())
+    if (active_sheets.is_empty())
         this->set_idle(true);
 }
 
@@ -879,6 +880,7 @@ bool Binder::on_initialization(const YAML::Node& node)
                 active_sheet_id = id;
 
             auto sheet = sheets.emplace(id, std::make_shared<Sheet>(false)).first->second;
+            sheet->set_scheduler(&active_sheets);
             sheet->disclose_size(this->get_size());
             sheet->set_position(this->get_tlc(), Origin::TopLeftCorner);
             sheet->set_visible(this->is_visible() && active_sheet_id == id ? true : false);
@@ -943,5 +945,5 @@ void Binder::draw(sf::RenderTarget& target, sf::RenderStates states) const
     for (auto& [id, sheet] : sheets)
         if (!sheet->is_idle() && active_sheet != sheet)
             target.draw(*sheet, states);
-    target.draw(*active_sheet);
+    target.draw(*active_sheet, states);
 }
\ No newline at end of file
@@ -128,6 +128,7 @@ private:
     bool horizontal_flip;
 
     tsl::ordered_map<ID, std::shared_ptr<Element>> elements;
+    ActiveSet active_elements;
     std::unordered_map<ID, PxVec2> local_element_positions;
     std::shared_ptr<Element> active_element;
     std::shared_ptr<Element> hovered_element;
@@ -204,6 +205,7 @@ private:
 
 private:
     tsl::ordered_map<ID, std::shared_ptr<Sheet>> sheets;
+    ActiveSet active_sheets;
     std::shared_ptr<Sheet> active_sheet;
     std::string active_sheet_id;
     Seconds sheet_turn_cooldown;
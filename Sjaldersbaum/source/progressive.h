@@ -55,6 +55,37 @@ inline bool blend(const bool b1, const bool b2, const float factor)
 
 /*------------------------------------------------------------------------------------------------*/
 
+// Shapes the progress of a ProgressiveValue; i.e. how the blend factor follows time.
+// In starts slowly, Out ends slowly, InOut does both.
+enum class Easing
+{
+    Linear,
+    In,
+    Out,
+    InOut
+};
+
+// Maps linear progress [0-1] to eased progress [0-1].
+inline float ease(const float progress, const Easing easing)
+{
+    switch (easing)
+    {
+    case Easing::In:
+        return progress * progress * progress;
+    case Easing::Out:
+    {
+        const float inverse = 1.f - progress;
+        return 1.f - inverse * inverse * inverse;
+    }
+    case Easing::InOut:
+        return progress * progress * (3.f - 2.f * progress);
+    default:
+        return progress;
+    }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 // Interface to an object of type T, whose value can be set progressively, using blend<T>.
 template<typename T>
 class ProgressiveValue
@@ -68,6 +99,9 @@ public:
     // The current value will take this long to turn (blend) into the target value.
     void set_progression_duration(Seconds duration);
 
+    // Applies to the ongoing progression as well. Linear by default.
+    void set_easing(Easing easing);
+
     void set_target(T target, bool restart_progress = true);
     void set_current(T current);
 
@@ -82,6 +116,7 @@ private:
     mutable bool changed_since_last_check;
     Seconds progression_duration;
     float progress;
+    Easing easing;
     T before;
     T current;
     T target;
@@ -97,7 +132,8 @@ ProgressiveValue<T>::ProgressiveValue(T initial, Seconds progression_duration) :
     target { initial },
     changed_since_last_check{ true },
     progression_duration{ progression_duration },
-    progress{ 1.f }
+    progress{ 1.f },
+    easing{ Easing::Linear }
 {
 
 }
@@ -116,7 +152,7 @@ void ProgressiveValue<T>::update(const Seconds elapsed_time)
     if (progress >= 1.f)
         current = target;
     else
-        current = blend<T>(before, target, progress);
+        current = blend<T>(before, target, ease(progress, easing));
 
     changed_since_last_check = true;
 }
@@ -127,6 +163,12 @@ void ProgressiveValue<T>::set_progression_duration(const Seconds duration)
     progression_duration = duration;
 }
 
+template<typename T>
+void ProgressiveValue<T>::set_easing(const Easing easing)
+{
+    this->easing = easing;
+}
+
 template<typename T>
 void ProgressiveValue<T>::set_target(const T target, const bool restart_progress)
 {
@@ -16,13 +16,15 @@ class ResourceReference;
 using TextureReference     = ResourceReference<sf::Texture>;
 using FontReference        = ResourceReference<sf::Font>;
 using SoundBufferReference = ResourceReference<sf::SoundBuffer>;
+using ImageReference       = ResourceReference<sf::Image>;
 
 /*------------------------------------------------------------------------------------------------*/
 
 // Refers to a resource of type T. Think shared_ptr, but easier to use.
 // Construction/copying increments the underlying resource's reference count.
 // Destruction/overcopying decrements the underlying resource's reference count.
-// The underlying resource is destructed if its reference count hits 0.
+// The underlying resource may be destructed once its reference count hits 0.
+// Only the load methods deal with paths; copying and destruction operate on an integer handle.
 template<typename T>
 class ResourceReference
 {
@@ -39,21 +41,32 @@ public:
     // Loads the resource from specified path and starts referring to it.
     // If a resource has already been loaded from specified path, starts referring to it.
     // If the load is unsuccessful, an empty resource still exists and will be referred to.
-    void load(std::string resource_path);
+    void load(const std::string& resource_path);
+
+    // Like load(), but a resource that is not loaded yet is decoded in the background;
+    // until then, an empty placeholder is referred to. See ResourceManager::get_async().
+    void load_async(const std::string& resource_path);
 
     // Note that the returned resource must only be used for as long as the reference is alive.
     // If no resource is loaded, returns an empty (default-constructed) resource.
     const T& get() const;
 
-    // Returns the path from which the resource was loaded from.
-    const std::string& get_path() const;
+    // Returns the (decapitalized) path from which the resource was loaded from.
+    std::string get_path() const;
 
-    // Returns true if the load method has been called. See load(std::string resource_path).
+    // Returns true if the load method has been called. See load(const std::string& resource_path).
     bool is_loaded() const;
 
+    // Returns false while an asynchronously loaded resource is still a placeholder.
+    bool is_ready() const;
+
+private:
+    // Starts referring to handle (and stops referring to the previous one).
+    void refer_to(ResourceHandle handle);
+
 private:
     const T* resource;
-    std::string resource_path;
+    ResourceHandle handle;
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -61,8 +74,8 @@ private:
 
 template<typename T>
 inline ResourceReference<T>::ResourceReference() :
-    resource     { nullptr },
-    resource_path{ "" }
+    resource{ nullptr },
+    handle  { NULL_RESOURCE }
 {
 
 }
@@ -91,7 +104,7 @@ inline ResourceReference<T>::ResourceReference(ResourceReference<T>&& other) :
 template<typename T>
 inline ResourceReference<T>::~ResourceReference()
 {
-    ResourceManager<T>::instance().decrement_reference_count(resource_path);
+    ResourceManager<T>::instance().decrement_reference_count(handle);
 }
 
 template<typename T>
@@ -99,14 +112,11 @@ inline ResourceReference<T>& ResourceReference<T>::operator=(const ResourceRefer
 {
     if (this == &other)
         return *this;
-    
-    if (resource_path != other.resource_path)
-    {
-        ResourceManager<T>::instance().decrement_reference_count(resource_path);
-        ResourceManager<T>::instance().increment_reference_count(other.resource_path);
 
-        resource      = other.resource;
-        resource_path = other.resource_path;
+    if (handle != other.handle)
+    {
+        refer_to(other.handle);
+        resource = other.resource;
     }
 
     return *this;
@@ -118,25 +128,30 @@ inline ResourceReference<T>& ResourceReference<T>::operator=(ResourceReference<T
     if (this == &other)
         return *this;
 
-    resource      = std::move(other.resource);
-    resource_path = std::move(other.resource_path);
+    // The other's reference count is taken over, so only ours has to be released:
+    ResourceManager<T>::instance().decrement_reference_count(handle);
+
+    resource = other.resource;
+    handle   = other.handle;
 
     other.resource = nullptr;
-    other.resource_path.clear();
+    other.handle   = NULL_RESOURCE;
 
     return *this;
 }
 
 template<typename T>
-inline void ResourceReference<T>::load(std::string resource_path)
+inline void ResourceReference<T>::load(const std::string& resource_path)
 {
-    decapitalize(resource_path);
-
-    ResourceManager<T>::instance().decrement_reference_count(this->resource_path);
-    ResourceManager<T>::instance().increment_reference_count(resource_path);
+    refer_to(ResourceManager<T>::instance().intern(resource_path));
+    resource = &ResourceManager<T>::instance().get(handle);
+}
 
-    resource = &ResourceManager<T>::instance().get(resource_path);
-    this->resource_path = std::move(resource_path);
+template<typename T>
+inline void ResourceReference<T>::load_async(const std::string& resource_path)
+{
+    refer_to(ResourceManager<T>::instance().intern(resource_path));
+    resource = &ResourceManager<T>::instance().get_async(handle);
 }
 
 template<typename T>
@@ -152,13 +167,28 @@ inline const T& ResourceReference<T>::get() const
 }
 
 template<typename T>
-inline const std::string& ResourceReference<T>::get_path() const
+inline std::string ResourceReference<T>::get_path() const
 {
-    return resource_path;
+    return ResourceManager<T>::instance().get_path(handle);
 }
 
 template<typename T>
 inline bool ResourceReference<T>::is_loaded() const
 {
     return resource != nullptr;
+}
+
+template<typename T>
+inline bool ResourceReference<T>::is_ready() const
+{
+    return ResourceManager<T>::instance().is_ready(handle);
+}
+
+template<typename T>
+inline void ResourceReference<T>::refer_to(const ResourceHandle handle)
+{
+    // Increment first, so re-referring to the same resource never lets its count hit 0:
+    ResourceManager<T>::instance().increment_reference_count(handle);
+    ResourceManager<T>::instance().decrement_reference_count(this->handle);
+    this->handle = handle;
 }
\ No newline at end of file
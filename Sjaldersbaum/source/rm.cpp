@@ -0,0 +1,110 @@
+#include "rm.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <SFML/OpenGL.hpp>
+
+namespace fs = std::filesystem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+extern const std::unordered_map<std::string, MipmapPolicy> KNOWN_MIPMAP_POLICIES
+{
+    { "none",        MipmapPolicy::None },
+    { "generate",    MipmapPolicy::Generate },
+    { "precomputed", MipmapPolicy::Precomputed }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Replaces generated mip levels with the ones found next to the texture:
+// "textures/table.png" -> "textures/table_mip1.png", "textures/table_mip2.png", ...
+// Stops at the first missing (or mismatched) level; the remaining levels stay generated.
+void load_precomputed_mipmaps(sf::Texture& texture, const std::string& path)
+{
+    const fs::path base_path{ path };
+
+    unsigned int width  = texture.getSize().x;
+    unsigned int height = texture.getSize().y;
+
+    for (int level = 1; width > 1u || height > 1u; ++level)
+    {
+        width  = std::max(width  / 2u, 1u);
+        height = std::max(height / 2u, 1u);
+
+        fs::path level_path = base_path;
+        level_path.replace_filename(base_path.stem().string() + "_mip" + Convert::to_str(level) +
+                                    base_path.extension().string());
+
+        if (!exists_in_archive_or_drive(level_path.string()))
+            break;
+
+        sf::Image image;
+        if (!load_from_archive_or_drive(image, level_path.string()))
+            break;
+
+        if (image.getSize() != sf::Vector2u{ width, height })
+        {
+            LOG_ALERT("precomputed mip level has invalid size; expected " +
+                      Convert::to_str(width) + 'x' + Convert::to_str(height) + ":\n" +
+                      level_path.string());
+            break;
+        }
+
+        sf::Texture::bind(&texture);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0,
+                        static_cast<GLsizei>(width), static_cast<GLsizei>(height),
+                        GL_RGBA, GL_UNSIGNED_BYTE, image.getPixelsPtr());
+        sf::Texture::bind(nullptr);
+
+        if (RESOURCE_LOGGING)
+            LOG_DEBUG("LOADED MIP LEVEL: " + level_path.string());
+    }
+}
+
+void apply_mipmap_policy(sf::Texture& texture, const std::string& path, const MipmapPolicy policy)
+{
+    if (policy == MipmapPolicy::None || texture.getSize().x == 0u)
+        return;
+
+    // Fails if the driver does not support mipmaps, in which case plain filtering remains.
+    if (!texture.generateMipmap())
+    {
+        LOG_INTEL("mipmaps could not be generated for:\n" + path);
+        return;
+    }
+
+    if (policy == MipmapPolicy::Precomputed)
+        load_precomputed_mipmaps(texture, path);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool decode(DecodedResource<sf::Texture>& decoded, const std::string& path)
+{
+    return load_image(decoded.image, path);
+}
+
+bool decode(DecodedResource<sf::SoundBuffer>& decoded, const std::string& path)
+{
+    sf::InputSoundFile file;
+    if (!open_from_archive_or_drive(file, path))
+        return false;
+
+    decoded.samples.resize(static_cast<size_t>(file.getSampleCount()));
+    decoded.channel_count = file.getChannelCount();
+    decoded.sample_rate   = file.getSampleRate();
+
+    return file.read(decoded.samples.data(), decoded.samples.size()) == decoded.samples.size();
+}
+
+bool upload(sf::Texture& texture, const DecodedResource<sf::Texture>& decoded)
+{
+    return texture.loadFromImage(decoded.image);
+}
+
+bool upload(sf::SoundBuffer& buffer, const DecodedResource<sf::SoundBuffer>& decoded)
+{
+    return buffer.loadFromSamples(decoded.samples.data(), decoded.samples.size(),
+                                  decoded.channel_count, decoded.sample_rate);
+}
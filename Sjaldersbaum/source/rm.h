@@ -3,6 +3,10 @@
 #include <string>
 #include <unordered_map>
 #include <iomanip>
+#include <future>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 
@@ -10,11 +14,24 @@
 #include "logger.h"
 #include "contains.h"
 #include "units.h"
+#include "string_assist.h"
+#include "texture_cache.h"
+#include "thread_pool.h"
+#include "file_watcher.h"
+#include "archive.h"
 
 /*------------------------------------------------------------------------------------------------*/
 
 extern bool RESOURCE_LOGGING;
 
+/*------------------------------------------------------------------------------------------------*/
+
+// Compact identifier of an (interned) resource path; see ResourceManager::intern().
+using ResourceHandle = std::uint32_t;
+
+// Handle of the empty path; refers to no resource.
+constexpr ResourceHandle NULL_RESOURCE = 0u;
+
 /*------------------------------------------------------------------------------------------------*/
 // Known types of shared resources:
 
@@ -24,34 +41,102 @@ class ResourceManager;
 using TextureManager     = ResourceManager<sf::Texture>;
 using FontManager        = ResourceManager<sf::Font>;
 using SoundBufferManager = ResourceManager<sf::SoundBuffer>;
+using ImageManager       = ResourceManager<sf::Image>;
 
 /*------------------------------------------------------------------------------------------------*/
 
-extern const Seconds RESOURCE_DESTRUCTION_INTERVAL;
+// Determines how a texture is sampled when minified (e.g. when the camera zooms out).
+enum class MipmapPolicy
+{
+    None,       // plain bilinear filtering
+    Generate,   // mip levels are generated upon loading
+    Precomputed // like Generate, but levels found on disk ("<stem>_mip<N><ext>") are used instead
+};
+
+// Policies: [none, generate, precomputed]
+extern const std::unordered_map<std::string, MipmapPolicy> KNOWN_MIPMAP_POLICIES;
+
+// Applies policy to a texture that has just been loaded from path.
+void apply_mipmap_policy(sf::Texture& texture, const std::string& path, MipmapPolicy policy);
+
+/*------------------------------------------------------------------------------------------------*/
+
+// CPU-side data of a resource; decoded on a worker thread, then uploaded on the main thread.
+// Fonts have none, as SFML reads their glyphs from file on demand anyway; images are their own.
+template<typename T>
+struct DecodedResource;
+
+template<>
+struct DecodedResource<sf::Texture>
+{
+    sf::Image image;
+};
+
+template<>
+struct DecodedResource<sf::SoundBuffer>
+{
+    std::vector<sf::Int16> samples;
+    unsigned int channel_count = 0u;
+    unsigned int sample_rate   = 0u;
+};
+
+// Thread-safe; does not touch any OpenGL/OpenAL objects.
+bool decode(DecodedResource<sf::Texture>& decoded, const std::string& path);
+bool decode(DecodedResource<sf::SoundBuffer>& decoded, const std::string& path);
+
+// Main thread only.
+bool upload(sf::Texture& texture, const DecodedResource<sf::Texture>& decoded);
+bool upload(sf::SoundBuffer& buffer, const DecodedResource<sf::SoundBuffer>& decoded);
+
+/*------------------------------------------------------------------------------------------------*/
 
 // Singleton for loading/storing resources and providing shared access ("reference") to them.
+// Paths are interned into handles once; all bookkeeping is then done in a dense array.
 template<typename T>
 class ResourceManager
 {
 public:
     static ResourceManager& instance();
 
-    // Progresses any unreferenced resources towards their destruction.
-    void update(Seconds elapsed_time);
+    // Finishes asynchronous loads whose decoding is done;
+    // if over budget, destructs unreferenced resources, least recently used first.
+    void update();
 
-    // Returns a reference to a resource loaded from specified path (also loading it if necessary).
+    // Returns the handle of path (case-insensitive), creating one if necessary.
+    // Handles are never invalidated. Does not load anything; an empty path yields NULL_RESOURCE.
+    ResourceHandle intern(const std::string& path);
+
+    // Returns the (decapitalized) path that handle was interned from.
+    const std::string& get_path(ResourceHandle handle) const;
+
+    // Returns a reference to a resource loaded from handle's path (also loading it if necessary).
     // If the load is unsuccessful, an empty resource will still be returned.
+    // The reference remains valid for as long as the resource is referenced.
+    const T& get(ResourceHandle handle);
     const T& get(const std::string& path);
 
+    // Like get(), but a resource that is not loaded yet is decoded on a worker thread instead.
+    // Meanwhile, the returned reference refers to an empty placeholder (e.g. an empty texture,
+    // or silence), which update() turns into the actual resource once decoding is done.
+    // Fonts and images are always loaded synchronously.
+    const T& get_async(ResourceHandle handle);
+
+    // Returns false while the resource is still being decoded.
+    bool is_ready(ResourceHandle handle) const;
+
     // Returns a reference to a default-constructed resource that is never destructed.
     const T& get_default();
 
-    // Must be called whenever getting() or copying a resource loaded from this path.
-    void increment_reference_count(const std::string& path);
+    // Must be called whenever getting() or copying a resource with this handle.
+    void increment_reference_count(ResourceHandle handle);
+
+    // Must be called whenever a resource with this handle is no longer being used.
+    // Once its reference count hits 0, a resource is kept until the manager exceeds its budget.
+    void decrement_reference_count(ResourceHandle handle);
 
-    // Must be called whenever a resource loaded from this path is no longer being used.
-    // A resource is destructed shortly after its reference count hits 0.
-    void decrement_reference_count(const std::string& path);
+    // Sets the (estimated) memory budget. Referenced resources are never destructed,
+    // so the budget can only be exceeded by resources that are actually in use.
+    void set_byte_budget(size_t bytes);
 
     // Returns a string containing all loaded resources of type T, and their reference counts.
     // Specifically for the "rsrcs" command.
@@ -60,13 +145,72 @@ public:
     // For development; does not perform any checks.
     void reload_all();
 
+    // For development; reloads the resource loaded from path, if there is one.
+    void reload(const std::string& path);
+
+    // Textures only. Sets the MipmapPolicy of the texture loaded from path (Generate by default).
+    // If the texture is already loaded, it is reloaded in place to apply the new policy.
+    void set_mipmap_policy(const std::string& path, MipmapPolicy policy);
+
+    // Textures only. Returns the MipmapPolicy set for path (Generate by default).
+    MipmapPolicy get_mipmap_policy(const std::string& path) const;
+
+private:
+    struct Entry
+    {
+        std::string path;
+        std::unique_ptr<T> resource; // nullptr while not loaded; keeps the address stable.
+        int reference_count = 0;
+        size_t size = 0u;
+        MipmapPolicy mipmap_policy = MipmapPolicy::Generate;
+
+        // Loaded, unreferenced entries form an intrusive, circular LRU list,
+        // with the NULL_RESOURCE entry acting as its sentinel:
+        ResourceHandle lru_previous = NULL_RESOURCE;
+        ResourceHandle lru_next     = NULL_RESOURCE;
+        bool queued = false;
+
+        std::shared_ptr<DecodedResource<T>> decoded;
+        std::future<bool> decode_success;
+        bool pending = false;
+    };
+
+    // Loads resource from path (or the archive); textures and images go through the texture cache.
+    bool load(T& resource, const std::string& path);
+
+    // Performs type-specific setup and bookkeeping after an entry's resource has been (re)loaded.
+    void on_load(ResourceHandle handle);
+
+    // Uploads the decoded data to the placeholder; blocks if decoding is not done yet.
+    void finish_pending_load(ResourceHandle handle);
+
+    // Waits for the entry's unfinished decode (if any), then throws its result away;
+    // so that it is never decoded twice at once, nor outlived by its worker.
+    void discard_pending_load(ResourceHandle handle);
+
+    // Estimates the memory used by a resource:
+    // textures by dimensions (+1/3 for mipmaps), images by dimensions, sound buffers by samples,
+    // fonts by file size.
+    size_t estimate_size(const Entry& entry) const;
+
+    void enqueue(ResourceHandle handle);
+    void dequeue(ResourceHandle handle);
+
+    void destruct(ResourceHandle handle);
+
+    static constexpr bool ASYNC_DECODING = !std::is_same<T, sf::Font>::value &&
+                                           !std::is_same<T, sf::Image>::value;
+
 private:
-    std::unordered_map<std::string, T> resources;
-    std::unordered_map<std::string, int> reference_counts;
-    std::unordered_map<std::string, Seconds> destruction_timers;
+    std::vector<Entry> entries; // Indexed by handle.
+    std::unordered_map<std::string, ResourceHandle> handles;
+    std::vector<ResourceHandle> pending_handles;
+
+    size_t total_size = 0u;
+    size_t byte_budget = SIZE_MAX;
 
 private:
-    ResourceManager() = default;
+    ResourceManager();
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager(ResourceManager&&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
@@ -75,11 +219,21 @@ private:
 
 /*------------------------------------------------------------------------------------------------*/
 
-inline void update_resource_managers(const Seconds elapsed_time)
+inline void update_resource_managers()
+{
+    TextureManager::instance().update();
+    FontManager::instance().update();
+    SoundBufferManager::instance().update();
+    ImageManager::instance().update();
+}
+
+// For development; reloads the resource loaded from path, whichever its type.
+inline void reload_resource(const std::string& path)
 {
-    TextureManager::instance().update(elapsed_time);
-    FontManager::instance().update(elapsed_time);
-    SoundBufferManager::instance().update(elapsed_time);
+    TextureManager::instance().reload(path);
+    FontManager::instance().reload(path);
+    SoundBufferManager::instance().reload(path);
+    ImageManager::instance().reload(path);
 }
 
 inline void log_all_loaded_resources()
@@ -89,7 +243,9 @@ inline void log_all_loaded_resources()
         "--------- FONTS ------------------------------------------------------\n" +
         FontManager::instance().get_data_as_formatted_string() + '\n' +
         "--------- SOUND-BUFFERS ----------------------------------------------\n" +
-        SoundBufferManager::instance().get_data_as_formatted_string());
+        SoundBufferManager::instance().get_data_as_formatted_string() + '\n' +
+        "--------- IMAGES -----------------------------------------------------\n" +
+        ImageManager::instance().get_data_as_formatted_string());
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -103,51 +259,133 @@ inline ResourceManager<T>& ResourceManager<T>::instance()
 }
 
 template<typename T>
-inline void ResourceManager<T>::update(const Seconds elapsed_time)
+inline ResourceManager<T>::ResourceManager()
 {
-    for (auto it = destruction_timers.begin(); it != destruction_timers.end();)
+    entries.emplace_back(); // NULL_RESOURCE
+    handles.emplace("", NULL_RESOURCE);
+}
+
+template<typename T>
+inline void ResourceManager<T>::update()
+{
+    for (size_t i = 0u; i < pending_handles.size();)
     {
-        auto& timer = it->second;
-        timer -= elapsed_time;
+        const ResourceHandle handle = pending_handles[i];
+        Entry& entry = entries[handle];
 
-        if (timer <= 0.f)
+        // Finished (by get()) or destructed in the meantime:
+        if (!entry.pending)
         {
-            resources.erase(it->first);
-            if (RESOURCE_LOGGING)
-                LOG_INTEL("UNLOADED: " + it->first);
-
-            it = destruction_timers.erase(it);
+            pending_handles[i] = pending_handles.back();
+            pending_handles.pop_back();
+        }
+        else if (entry.decode_success.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready)
+        {
+            finish_pending_load(handle);
+            pending_handles[i] = pending_handles.back();
+            pending_handles.pop_back();
         }
         else
-            ++it;
+            ++i;
     }
+
+    while (total_size > byte_budget && entries[NULL_RESOURCE].lru_next != NULL_RESOURCE)
+        destruct(entries[NULL_RESOURCE].lru_next);
 }
 
 template<typename T>
-inline const T& ResourceManager<T>::get(const std::string& path)
+inline ResourceHandle ResourceManager<T>::intern(const std::string& path)
+{
+    if (auto it = handles.find(path); it != handles.end())
+        return it->second;
+
+    // Other spellings of the same path share a handle:
+    std::string decapitalized_path = get_decapitalized(path);
+    if (auto it = handles.find(decapitalized_path); it != handles.end())
+    {
+        handles.emplace(path, it->second);
+        return it->second;
+    }
+
+    const ResourceHandle handle = static_cast<ResourceHandle>(entries.size());
+    entries.emplace_back().path = decapitalized_path;
+    if (path != decapitalized_path)
+        handles.emplace(path, handle);
+    handles.emplace(std::move(decapitalized_path), handle);
+
+    return handle;
+}
+
+template<typename T>
+inline const std::string& ResourceManager<T>::get_path(const ResourceHandle handle) const
+{
+    return entries[handle].path;
+}
+
+template<typename T>
+inline const T& ResourceManager<T>::get(const ResourceHandle handle)
 {
-    if (path.empty())
+    if (handle == NULL_RESOURCE)
     {
         LOG_INTEL("resource with empty path; assuming default (empty) value.");
         return get_default();
     }
 
-    if (!contains(resources, path))
+    Entry& entry = entries[handle];
+    if (entry.pending)
+        finish_pending_load(handle);
+    else if (!entry.resource)
     {
-        T& resource = resources.emplace(path, T()).first->second;
-        if (resource.loadFromFile(path))
+        entry.resource = std::make_unique<T>();
+        if (load(*entry.resource, entry.path))
         {
             if (RESOURCE_LOGGING)
-                LOG_INTEL("LOADED: " + path);
+                LOG_DEBUG("LOADED: " + entry.path);
         }
         else
-            LOG_ALERT("resource could not be loaded:\n" + path);
+            LOG_ALERT("resource could not be loaded:\n" + entry.path);
+
+        on_load(handle);
+    }
+
+    return *entry.resource;
+}
+
+template<typename T>
+inline const T& ResourceManager<T>::get(const std::string& path)
+{
+    return get(intern(path));
+}
 
-        if constexpr (std::is_same<T, sf::Texture>::value)
-            resource.setSmooth(true);
+template<typename T>
+inline const T& ResourceManager<T>::get_async(const ResourceHandle handle)
+{
+    if constexpr (!ASYNC_DECODING)
+        return get(handle);
+    else
+    {
+        if (handle == NULL_RESOURCE || entries[handle].resource)
+            return get(handle);
+
+        Entry& entry = entries[handle];
+        entry.decoded = std::make_shared<DecodedResource<T>>();
+        entry.decode_success = ThreadPool::instance().submit(
+            [decoded = entry.decoded, path = entry.path]()
+            {
+                return decode(*decoded, path);
+            });
+        entry.pending = true;
+        pending_handles.push_back(handle);
+
+        entry.resource = std::make_unique<T>();
+        return *entry.resource;
     }
+}
 
-    return resources.at(path);
+template<typename T>
+inline bool ResourceManager<T>::is_ready(const ResourceHandle handle) const
+{
+    return !entries[handle].pending;
 }
 
 template<typename T>
@@ -158,38 +396,37 @@ inline const T& ResourceManager<T>::get_default()
 }
 
 template<typename T>
-inline void ResourceManager<T>::increment_reference_count(const std::string& path)
+inline void ResourceManager<T>::increment_reference_count(const ResourceHandle handle)
 {
-    if (path.empty())
+    if (handle == NULL_RESOURCE)
         return;
 
-    if (contains(reference_counts, path))
-        ++reference_counts[path];
-    else
-    {
-        reference_counts[path] = 1;
-        if (contains(destruction_timers, path))
-            destruction_timers.erase(path);
-    }
+    Entry& entry = entries[handle];
+    if (entry.reference_count++ == 0 && entry.queued)
+        dequeue(handle);
 }
 
 template<typename T>
-inline void ResourceManager<T>::decrement_reference_count(const std::string& path)
+inline void ResourceManager<T>::decrement_reference_count(const ResourceHandle handle)
 {
-    if (path.empty())
+    if (handle == NULL_RESOURCE)
         return;
 
-    if (contains(reference_counts, path))
+    Entry& entry = entries[handle];
+    if (entry.reference_count == 0)
     {
-        --reference_counts[path];
-        if (reference_counts[path] == 0)
-        {
-            reference_counts.erase(path);
-            destruction_timers.insert(std::make_pair(path, RESOURCE_DESTRUCTION_INTERVAL));
-        }
+        LOG_ALERT("cannot decrement unreferenced resource:\n" + entry.path);
+        return;
     }
-    else
-        LOG_ALERT("cannot decrement unreferenced resource:\n" + path);
+
+    if (--entry.reference_count == 0 && entry.resource)
+        enqueue(handle);
+}
+
+template<typename T>
+inline void ResourceManager<T>::set_byte_budget(const size_t bytes)
+{
+    byte_budget = bytes;
 }
 
 template<typename T>
@@ -201,23 +438,231 @@ inline std::string ResourceManager<T>::get_data_as_formatted_string() const
     std::stringstream buffer;
 
     // Used resources and their reference counts:
-    for (const auto& [resource_path, reference_count] : reference_counts)
+    for (const auto& entry : entries)
+        if (entry.reference_count > 0)
+            buffer << std::setw(66) << std::left  << std::setfill('.')
+                   << entry.path << '|'
+                   << std::setw(3)  << std::right << std::setfill(' ')
+                   << Convert::to_str(entry.reference_count) << '\n';
+
+    // Unreferenced resources, in order of destruction:
+    for (ResourceHandle handle = entries[NULL_RESOURCE].lru_next;
+         handle != NULL_RESOURCE;
+         handle = entries[handle].lru_next)
         buffer << std::setw(66) << std::left  << std::setfill('.')
-               << resource_path << '|'
-               << std::setw(3)  << std::right << std::setfill(' ')
-               << Convert::to_str(reference_count) << '\n';
+               << entries[handle].path << '|'
+               << std::setw(3)  << std::right << "lru\n";
+
+    buffer << "total: " << total_size / 1024u << " KiB; budget: ";
+    if (byte_budget == SIZE_MAX)
+        buffer << "none\n";
+    else
+        buffer << byte_budget / 1024u << " KiB\n";
 
-    // Resources about to be destructed:
-    for (const auto& [resource_path, destruction_timer] : destruction_timers)
-        buffer << std::setw(66) << std::left  << std::setfill('.')
-               << resource_path << '|'
-               << std::setw(3)  << std::right << "tbd\n";
-               
     return buffer.str();
 }
+
 template<typename T>
 inline void ResourceManager<T>::reload_all()
 {
-    for (auto& [path, resource] : resources)
-        resource.loadFromFile(path);
+    for (ResourceHandle handle = 1u; handle < entries.size(); ++handle)
+    {
+        Entry& entry = entries[handle];
+        if (!entry.resource)
+            continue;
+
+        discard_pending_load(handle);
+
+        load(*entry.resource, entry.path);
+        on_load(handle);
+    }
+}
+
+template<typename T>
+inline void ResourceManager<T>::reload(const std::string& path)
+{
+    const auto it = handles.find(path);
+    if (it == handles.end() || it->second == NULL_RESOURCE)
+        return;
+
+    const ResourceHandle handle = it->second;
+    Entry& entry = entries[handle];
+    if (!entry.resource)
+        return;
+
+    // The pending decode may have read the file before it changed:
+    discard_pending_load(handle);
+
+    if (load(*entry.resource, entry.path))
+        LOG_INTEL("RELOADED: " + entry.path);
+    else
+        LOG_ALERT("resource could not be reloaded:\n" + entry.path);
+
+    on_load(handle);
+}
+
+template<typename T>
+inline void ResourceManager<T>::set_mipmap_policy(const std::string& path, const MipmapPolicy policy)
+{
+    static_assert(std::is_same<T, sf::Texture>::value, "mipmap policies only apply to textures");
+
+    const ResourceHandle handle = intern(path);
+    if (handle == NULL_RESOURCE || entries[handle].mipmap_policy == policy)
+        return;
+
+    Entry& entry = entries[handle];
+    entry.mipmap_policy = policy;
+
+    // Pending loads apply the policy once they finish:
+    if (entry.resource && !entry.pending)
+    {
+        load(*entry.resource, entry.path);
+        on_load(handle);
+    }
+}
+
+template<typename T>
+inline MipmapPolicy ResourceManager<T>::get_mipmap_policy(const std::string& path) const
+{
+    static_assert(std::is_same<T, sf::Texture>::value, "mipmap policies only apply to textures");
+
+    const auto it = handles.find(path);
+    return it == handles.end() ? MipmapPolicy::Generate : entries[it->second].mipmap_policy;
+}
+
+template<typename T>
+inline bool ResourceManager<T>::load(T& resource, const std::string& path)
+{
+    if constexpr (std::is_same<T, sf::Texture>::value)
+        return load_texture(resource, path);
+    else if constexpr (std::is_same<T, sf::Image>::value)
+        return load_image(resource, path);
+    else
+        return load_from_archive_or_drive(resource, path);
+}
+
+template<typename T>
+inline void ResourceManager<T>::on_load(const ResourceHandle handle)
+{
+    Entry& entry = entries[handle];
+
+    if constexpr (std::is_same<T, sf::Texture>::value)
+    {
+        entry.resource->setSmooth(true);
+        apply_mipmap_policy(*entry.resource, entry.path, entry.mipmap_policy);
+    }
+
+    total_size -= entry.size;
+    entry.size = estimate_size(entry);
+    total_size += entry.size;
+
+    FileWatcher::instance().watch(entry.path);
+}
+
+template<typename T>
+inline void ResourceManager<T>::finish_pending_load(const ResourceHandle handle)
+{
+    if constexpr (ASYNC_DECODING)
+    {
+        Entry& entry = entries[handle];
+        entry.pending = false;
+
+        if (entry.decode_success.get() && upload(*entry.resource, *entry.decoded))
+        {
+            if (RESOURCE_LOGGING)
+                LOG_DEBUG("LOADED (ASYNC): " + entry.path);
+        }
+        else
+            LOG_ALERT("resource could not be loaded:\n" + entry.path);
+
+        entry.decoded.reset();
+        on_load(handle);
+    }
+}
+
+template<typename T>
+inline void ResourceManager<T>::discard_pending_load(const ResourceHandle handle)
+{
+    Entry& entry = entries[handle];
+
+    if (entry.decode_success.valid())
+        entry.decode_success.wait();
+
+    entry.pending = false;
+    entry.decoded.reset();
+    entry.decode_success = std::future<bool>{};
+}
+
+template<typename T>
+inline size_t ResourceManager<T>::estimate_size(const Entry& entry) const
+{
+    if constexpr (std::is_same<T, sf::Texture>::value)
+    {
+        const sf::Vector2u texture_size = entry.resource->getSize();
+
+        size_t size = static_cast<size_t>(texture_size.x) * texture_size.y * 4u;
+        if (entry.mipmap_policy != MipmapPolicy::None)
+            size += size / 3u;
+        return size;
+    }
+    else if constexpr (std::is_same<T, sf::SoundBuffer>::value)
+        return static_cast<size_t>(entry.resource->getSampleCount()) * sizeof(sf::Int16);
+    else if constexpr (std::is_same<T, sf::Image>::value)
+    {
+        const sf::Vector2u image_size = entry.resource->getSize();
+        return static_cast<size_t>(image_size.x) * image_size.y * 4u;
+    }
+    else
+    {
+        // Fonts are read from their file on demand; archived ones from the mapped archive:
+        if (const ArchivedFile* file = Archive::instance().find(entry.path))
+            return file->size;
+
+        std::error_code error;
+        const std::uintmax_t file_size = std::filesystem::file_size(entry.path, error);
+        return error ? 0u : static_cast<size_t>(file_size);
+    }
+}
+
+template<typename T>
+inline void ResourceManager<T>::enqueue(const ResourceHandle handle)
+{
+    Entry& entry = entries[handle];
+    Entry& sentinel = entries[NULL_RESOURCE];
+
+    entry.lru_previous = sentinel.lru_previous;
+    entry.lru_next     = NULL_RESOURCE;
+    entries[sentinel.lru_previous].lru_next = handle;
+    sentinel.lru_previous = handle;
+    entry.queued = true;
+}
+
+template<typename T>
+inline void ResourceManager<T>::dequeue(const ResourceHandle handle)
+{
+    Entry& entry = entries[handle];
+
+    entries[entry.lru_previous].lru_next = entry.lru_next;
+    entries[entry.lru_next].lru_previous = entry.lru_previous;
+    entry.lru_previous = entry.lru_next = NULL_RESOURCE;
+    entry.queued = false;
+}
+
+template<typename T>
+inline void ResourceManager<T>::destruct(const ResourceHandle handle)
+{
+    Entry& entry = entries[handle];
+    if (entry.queued)
+        dequeue(handle);
+
+    total_size -= entry.size;
+    entry.size = 0u;
+
+    // An unfinished decode completes into nothing:
+    discard_pending_load(handle);
+
+    entry.resource.reset();
+
+    if (RESOURCE_LOGGING)
+        LOG_DEBUG("UNLOADED: " + entry.path);
 }
\ No newline at end of file
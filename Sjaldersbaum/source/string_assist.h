@@ -3,6 +3,7 @@
 #include <cctype>
 #include <string>
 #include <optional>
+#include <sstream>
 
 #include "maths.h"
 
@@ -1,11 +1,40 @@
 #include "table.h"
 
+#include <algorithm>
+#include <cmath>
+#include <SFML/OpenGL.hpp>
+
 #include "maths.h"
 
+// Not every platform's OpenGL header goes beyond version 1.1:
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+
 const std::string REGULAR_WOOD_PATH = "resources/textures/tables/regular_wood.png";
 
+constexpr unsigned int DEFAULT_TILE_SIZE = 512u;
+constexpr unsigned int MIN_TILE_SIZE     = 64u;
+constexpr unsigned int MAX_TILE_SIZE     = 4096u;
+
+// Each mip level halves a tile's border, so the border of a tile with mipmaps is wide enough
+// to still reach into its neighbours at the last level; further levels are not used.
+constexpr int TILE_MIP_LEVELS    = 4;
+constexpr int TILE_MIPMAP_BORDER = 1 << TILE_MIP_LEVELS;
+
 /*------------------------------------------------------------------------------------------------*/
 
+Table::Table() :
+    unloaded_tile_count{ 0 },
+    lazy_tiles         { false },
+    mipmap_policy      { MipmapPolicy::Generate },
+    columns            { 0 },
+    rows               { 0 },
+    tile_size          { DEFAULT_TILE_SIZE }
+{
+
+}
+
 bool Table::assure_contains(Object& object) const
 {
     PxRect central_bounds;
@@ -36,9 +65,11 @@ PxRect Table::get_bounds() const
 
 bool Table::initialize(const YAML::Node& node)
 {
-    std::string texture_path = REGULAR_WOOD_PATH;
+                texture_path = REGULAR_WOOD_PATH;
                 size         = { 2700.f, 1500.f };
     PxVec2      bounds_size  = { size.x - 100.f, size.y - 100.f };
+    int         tile_side    = static_cast<int>(DEFAULT_TILE_SIZE);
+                lazy_tiles   = false;
 
     if (node.IsDefined())
     {
@@ -47,6 +78,8 @@ bool Table::initialize(const YAML::Node& node)
             const YAML::Node texture_node     = node["texture"];
             const YAML::Node size_node        = node["size"];
             const YAML::Node bounds_size_node = node["bounds"];
+            const YAML::Node tile_size_node   = node["tile_size"];
+            const YAML::Node lazy_tiles_node  = node["lazy_tiles"];
 
             if (texture_node.IsDefined())
                 texture_path = texture_node.as<std::string>();
@@ -58,36 +91,182 @@ bool Table::initialize(const YAML::Node& node)
                 bounds_size = bounds_size_node.as<PxVec2>();
             else
                 bounds_size = { size.x - 100.f, size.y - 100.f };
+
+            if (tile_size_node.IsDefined())
+                tile_side = tile_size_node.as<int>();
+
+            if (lazy_tiles_node.IsDefined())
+                lazy_tiles = lazy_tiles_node.as<bool>();
         }
         catch (const YAML::Exception& e)
         {
             LOG_ALERT("exception: " + e.what() + '\n' +
                       "invalid node; expected a map that consists of:\n"
-                      "========================================================\n"
-                      "* texture: <std::string> = <REGULAR_WOOD>\n"
-                      "* size:    <PxVec2>      = (2700, 1500)\n"
-                      "==ADVANCED==============================================\n"
-                      "* bounds:  <PxVec2>      = (size.x - 100, size.y - 100)\n"
-                      "========================================================\n"
+                      "===========================================================\n"
+                      "* texture:    <std::string> = <REGULAR_WOOD>\n"
+                      "* size:       <PxVec2>      = (2700, 1500)\n"
+                      "==ADVANCED=================================================\n"
+                      "* bounds:     <PxVec2>      = (size.x - 100, size.y - 100)\n"
+                      "* tile_size:  <int>         = 512\n"
+                      "* lazy_tiles: <bool>        = false\n"
+                      "===========================================================\n"
+                      "lazy_tiles defers uploading tiles only; the texture is decoded at once.\n"
                       "DUMP:\n" + YAML::Dump(node));
             return false;
         }
     }
 
-    texture.load(texture_path);
-    background.setTexture(texture.get(), true);
-    background.setOrigin(PxVec2{ texture.get().getSize() } / 2.f);
+    if (!assure_bounds(tile_side, static_cast<int>(MIN_TILE_SIZE), static_cast<int>(MAX_TILE_SIZE)))
+        LOG_ALERT("invalid tile_size had to be adjusted; [64-4096]");
+    tile_size = static_cast<unsigned int>(tile_side);
 
     if (!(assure_bounds(size.x, 1.f, PX_LIMIT) &
           assure_bounds(size.y, 1.f, PX_LIMIT)))
         LOG_ALERT("invalid size had to be adjusted.");
-    set_size(background, size);
+
+    decapitalize(texture_path);
+    create_tiles();
+
     bounds.setSizeKeepCenter(bounds_size);
 
     return true;
 }
 
+bool Table::uses_texture(const std::string& path) const
+{
+    return path == texture_path;
+}
+
+void Table::reload_texture()
+{
+    create_tiles();
+}
+
+void Table::create_tiles()
+{
+    // The decoded image is shared through the ImageManager, so reloading a level
+    // (or another level with the same table) does not decode it again:
+    source_image.load(texture_path);
+
+    // Set through the level's texture policies, like those of any other texture:
+    mipmap_policy = TextureManager::instance().get_mipmap_policy(texture_path);
+
+    sf::Vector2u texture_size = source_image.get().getSize();
+
+    tiles.clear();
+    if (texture_size.x == 0u || texture_size.y == 0u)
+    {
+        // A texture that could not be loaded leaves a single black tile:
+        LOG_ALERT("table texture could not be loaded:\n" + texture_path);
+        source_image = ImageReference{};
+        texture_size = { 1u, 1u };
+
+        sf::Image black_image;
+        black_image.create(1u, 1u, sf::Color::Black);
+
+        Tile& tile = tiles.emplace_back();
+        tile.texture.loadFromImage(black_image);
+        tile.sprite.setTexture(tile.texture, true);
+        tile.loaded = true;
+
+        columns = rows = 1;
+        unloaded_tile_count = 0;
+    }
+    else
+    {
+        columns = static_cast<int>((texture_size.x + tile_size - 1u) / tile_size);
+        rows    = static_cast<int>((texture_size.y + tile_size - 1u) / tile_size);
+
+        tiles.resize(static_cast<size_t>(columns * rows));
+        unloaded_tile_count = columns * rows;
+
+        if (!lazy_tiles)
+            for (int row = 0; row < rows; ++row)
+                for (int column = 0; column < columns; ++column)
+                    load_tile(column, row);
+    }
+
+    transform = sf::Transform::Identity;
+    transform.scale(size.x / texture_size.x, size.y / texture_size.y);
+    transform.translate(-PxVec2{ texture_size } / 2.f);
+}
+
+void Table::load_tile(const int column, const int row) const
+{
+    Tile& tile = tiles[static_cast<size_t>(row * columns + column)];
+    if (tile.loaded)
+        return;
+
+    const sf::Image& image = source_image.get();
+    const sf::Vector2u image_size = image.getSize();
+
+    const int left   = column * static_cast<int>(tile_size);
+    const int top    = row    * static_cast<int>(tile_size);
+    const int right  = std::min(left + static_cast<int>(tile_size), static_cast<int>(image_size.x));
+    const int bottom = std::min(top  + static_cast<int>(tile_size), static_cast<int>(image_size.y));
+
+    // Include a border (where a neighbouring tile exists), so filtering samples continue
+    // into the neighbour instead of clamping at the tile's edge:
+    const int border = mipmap_policy == MipmapPolicy::None ? 1 : TILE_MIPMAP_BORDER;
+
+    const int border_left   = column > 0 ? std::min(border, left) : 0;
+    const int border_top    = row    > 0 ? std::min(border, top)  : 0;
+    const int border_right  = std::min(border, static_cast<int>(image_size.x) - right);
+    const int border_bottom = std::min(border, static_cast<int>(image_size.y) - bottom);
+
+    const sf::IntRect area{ left - border_left,
+                            top  - border_top,
+                            right  - left + border_left + border_right,
+                            bottom - top  + border_top  + border_bottom };
+
+    if (!tile.texture.loadFromImage(image, area))
+        LOG_ALERT("table tile could not be created: " +
+                  Convert::to_str(column) + ", " + Convert::to_str(row));
+    tile.texture.setSmooth(true);
+
+    // Precomputed levels cover the whole texture rather than a tile; tiles generate theirs.
+    if (mipmap_policy != MipmapPolicy::None && tile.texture.generateMipmap())
+    {
+        sf::Texture::bind(&tile.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, TILE_MIP_LEVELS);
+        sf::Texture::bind(nullptr);
+    }
+
+    tile.sprite.setTexture(tile.texture);
+    tile.sprite.setTextureRect({ border_left, border_top, right - left, bottom - top });
+    tile.sprite.setPosition(static_cast<Px>(left), static_cast<Px>(top));
+    tile.loaded = true;
+
+    // Once every tile resides on the GPU, the decoded image is left to the ImageManager's budget:
+    if (--unloaded_tile_count == 0)
+        source_image = ImageReference{};
+}
+
 void Table::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-    target.draw(background, states);
+    if (tiles.empty())
+        return;
+
+    states.transform *= transform;
+
+    // Visible region of the table, in texture coordinates:
+    const sf::View& view = target.getView();
+    const sf::FloatRect visible_area = states.transform.getInverse().transformRect(
+        view.getInverseTransform().transformRect({ -1.f, -1.f, 2.f, 2.f }));
+
+    const Px tile_side = static_cast<Px>(tile_size);
+
+    const int first_column = std::max(static_cast<int>(std::floor(visible_area.left / tile_side)), 0);
+    const int first_row    = std::max(static_cast<int>(std::floor(visible_area.top  / tile_side)), 0);
+    const int last_column  = std::min(static_cast<int>(std::floor(
+        (visible_area.left + visible_area.width)  / tile_side)), columns - 1);
+    const int last_row     = std::min(static_cast<int>(std::floor(
+        (visible_area.top  + visible_area.height) / tile_side)), rows - 1);
+
+    for (int row = first_row; row <= last_row; ++row)
+        for (int column = first_column; column <= last_column; ++column)
+        {
+            load_tile(column, row);
+            target.draw(tiles[static_cast<size_t>(row * columns + column)].sprite, states);
+        }
 }
\ No newline at end of file
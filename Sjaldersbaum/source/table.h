@@ -11,9 +11,12 @@
 
 // Objects are drawn on top of and bound by this.
 // The table is always centered at (0, 0).
+// Its texture is split into tiles, of which only those intersecting the view are drawn.
 class Table : public sf::Drawable, public YAML::Serializable
 {
 public:
+    Table();
+
     // If object's bounds are (fully) contained by the table's, returns true;
     // otherwise positions the object accordingly and returns false.
     bool assure_contains(Object& object) const;
@@ -23,20 +26,58 @@ public:
     PxRect get_bounds() const;
 
     // Expects a map that consists of:
-    // ========================================================
-    // * texture: <std::string> = <REGULAR_WOOD>
-    // * size:    <PxVec2>      = (2700, 1500)
-    // ==ADVANCED==============================================
-    // * bounds:  <PxVec2>      = (size.x - 100, size.y - 100)
-    // ========================================================
+    // ===========================================================
+    // * texture:    <std::string> = <REGULAR_WOOD>
+    // * size:       <PxVec2>      = (2700, 1500)
+    // ==ADVANCED=================================================
+    // * bounds:     <PxVec2>      = (size.x - 100, size.y - 100)
+    // * tile_size:  <int>         = 512
+    // * lazy_tiles: <bool>        = false
+    // ===========================================================
+    // With lazy_tiles, tiles are only uploaded to the GPU once they first become visible;
+    // the texture itself is still decoded as a whole, upon initialization.
+    // The texture's MipmapPolicy (see the level's textures) applies to every tile.
     bool initialize(const YAML::Node& node) override;
 
+    // Returns true if path is the file that the table's texture is decoded from.
+    bool uses_texture(const std::string& path) const;
+
+    // For development; splits the (reloaded) texture into tiles anew.
+    void reload_texture();
+
 private:
+    // Gets the decoded texture from the ImageManager and splits it into tiles.
+    void create_tiles();
+
+    // Uploads the tile's region of source_image (plus a 1px border shared with its neighbours,
+    // which prevents seams when filtering) to its texture.
+    void load_tile(int column, int row) const;
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
 private:
-    TextureReference texture;
-    sf::Sprite background;
+    struct Tile
+    {
+        sf::Texture texture;
+        sf::Sprite  sprite;
+        bool        loaded = false;
+    };
+
+    // Tiles are stored row by row and never reallocated (sprites point to their textures).
+    mutable std::vector<Tile> tiles;
+    mutable ImageReference source_image; // Kept only while some tiles are not yet loaded.
+    mutable int unloaded_tile_count;
+
+    std::string texture_path;
+    bool lazy_tiles;
+    MipmapPolicy mipmap_policy; // Of texture_path; tiles with mipmaps get a wider border.
+
+    int columns;
+    int rows;
+    unsigned int tile_size;
+
+    // Maps texture-space coordinates to table-space coordinates.
+    sf::Transform transform;
 
     PxVec2 size;
     PxRect bounds;
@@ -1,7 +1,15 @@
 #include "text_props.h"
 
+#include <tuple>
+#include <algorithm>
+
 /*------------------------------------------------------------------------------------------------*/
 
+extern bool RESOURCE_LOGGING;
+
+// Always prewarmed, along with the actual strings; covers most of what is typed and displayed.
+const std::string PREWARMED_CHARACTERS = MAIN_CHARACTERS + " 0123456789.,:;!?'\"()-_+=*&%#@<>[]";
+
 const std::unordered_map<std::string, sf::Text::Style> KNOWN_STYLES
 {
     { "regular",        sf::Text::Regular },
@@ -58,6 +66,13 @@ Px TextProps::get_max_width(const int ch_count) const
     return temp.getLocalBounds().width;
 }
 
+void TextProps::prewarm(const sf::String& str) const
+{
+    GlyphPrewarmer::instance().queue(*this, PREWARMED_CHARACTERS);
+    if (!str.isEmpty())
+        GlyphPrewarmer::instance().queue(*this, str);
+}
+
 bool TextProps::initialize(const YAML::Node& node)
 {
     std::string font_path;
@@ -132,4 +147,125 @@ bool TextProps::initialize(const YAML::Node& node)
         font.load(font_path);
 
     return true;
-}
\ No newline at end of file
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+void CharacterOffsets::rebuild(const sf::Text& text)
+{
+    const sf::String& str = text.getString();
+    offsets.assign(1u, 0.f);
+    offsets.reserve(str.getSize() + 1u);
+
+    const sf::Font* font = text.getFont();
+    if (!font)
+    {
+        offsets.resize(str.getSize() + 1u, 0.f);
+        return;
+    }
+
+    // Mirrors sf::Text::findCharacterPos(), but accumulates all offsets in a single pass:
+    const unsigned int size = text.getCharacterSize();
+    const bool bold = (text.getStyle() & sf::Text::Bold) != 0u;
+
+    Px whitespace_width = font->getGlyph(L' ', size, bold).advance;
+    const Px letter_spacing = (whitespace_width / 3.f) * (text.getLetterSpacing() - 1.f);
+    whitespace_width += letter_spacing;
+
+    Px x = 0.f;
+    sf::Uint32 previous_ch = 0u;
+    for (size_t i = 0u; i < str.getSize(); ++i)
+    {
+        const sf::Uint32 ch = str[i];
+        x += font->getKerning(previous_ch, ch, size);
+        previous_ch = ch;
+
+        if (ch == L' ')
+            x += whitespace_width;
+        else if (ch == L'\t')
+            x += whitespace_width * 4.f;
+        else if (ch == L'\n')
+            x = 0.f;
+        else
+            x += font->getGlyph(ch, size, bold).advance + letter_spacing;
+
+        offsets.push_back(x);
+    }
+}
+
+PxVec2 CharacterOffsets::get_position(const sf::Text& text, const size_t index) const
+{
+    if (offsets.empty())
+        return text.getTransform().transformPoint(0.f, 0.f);
+
+    return text.getTransform().transformPoint(offsets[std::min(index, offsets.size() - 1u)], 0.f);
+}
+
+size_t CharacterOffsets::find_index(const sf::Text& text, const PxVec2 point) const
+{
+    if (offsets.empty())
+        return 0u;
+
+    const Px x = text.getInverseTransform().transformPoint(point).x;
+
+    // Offsets only grow along a single line; the closest one is either side of x:
+    const auto next = std::lower_bound(offsets.begin(), offsets.end(), x);
+    if (next == offsets.begin())
+        return 0u;
+    if (next == offsets.end())
+        return offsets.size() - 1u;
+
+    const auto previous = std::prev(next);
+    return static_cast<size_t>((x - *previous <= *next - x ? previous : next) - offsets.begin());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool GlyphPrewarmer::GlyphStyle::operator<(const GlyphStyle& other) const
+{
+    return std::tie(font, size, bold, outline_thickness) <
+           std::tie(other.font, other.size, other.bold, other.outline_thickness);
+}
+
+void GlyphPrewarmer::queue(const TextProps& props, const sf::String& str)
+{
+    if (!props.font.is_loaded())
+        return;
+
+    const sf::Font* font = &props.font.get();
+    const unsigned int size = static_cast<unsigned int>(props.height);
+    const bool bold = (props.style & sf::Text::Bold) != 0u;
+
+    // The fill is drawn with unoutlined glyphs; an outline needs glyphs of its own:
+    std::vector<float> outline_thicknesses{ 0.f };
+    if (props.outline_thickness != 0.f)
+        outline_thicknesses.push_back(props.outline_thickness);
+
+    for (const float outline_thickness : outline_thicknesses)
+    {
+        GlyphGroup& group = queued_groups[GlyphStyle{ font, size, bold, outline_thickness }];
+        if (!group.font.is_loaded())
+            group.font = props.font;
+
+        for (size_t i = 0u; i < str.getSize(); ++i)
+            if (str[i] != '\n' && str[i] != '\t')
+                group.characters.insert(str[i]);
+    }
+}
+
+void GlyphPrewarmer::prewarm()
+{
+    size_t glyph_count = 0u;
+    for (const auto& [style, group] : queued_groups)
+    {
+        for (const sf::Uint32 character : group.characters)
+            group.font.get().getGlyph(character, style.size, style.bold, style.outline_thickness);
+        glyph_count += group.characters.size();
+    }
+
+    if (RESOURCE_LOGGING && !queued_groups.empty())
+        LOG_DEBUG("prewarmed " + Convert::to_str(glyph_count) + " glyphs in " +
+                  Convert::to_str(queued_groups.size()) + " styles.");
+
+    queued_groups.clear();
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <set>
 #include <SFML/Graphics.hpp>
 
 #include "yaml.h"
@@ -27,6 +29,10 @@ struct TextProps : public YAML::Serializable
     // Assumes the widest character is 'W'.
     Px get_max_width(int ch_count) const;
 
+    // Queues the glyphs of str (and of the common characters) to be rasterized ahead of time,
+    // in the font, size and style of these props. See GlyphPrewarmer.
+    void prewarm(const sf::String& str = "") const;
+
     // Expects a map that consists of:
     // =============================================================
     // * font:   <std::string>     = <FIRA_CODE>
@@ -57,4 +63,77 @@ public:
     float line_spacing_multiplier;
 
     PxVec2 offsets;
-};
\ No newline at end of file
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Caches the horizontal offsets of the characters of a single-line sf::Text, so that a caret can be
+// positioned, and a point can be mapped to an index, without sf::Text::findCharacterPos()
+// (which walks the string from its start on every call).
+// Must be rebuilt whenever the text's string, font, size, style or letter spacing change.
+class CharacterOffsets
+{
+public:
+    void rebuild(const sf::Text& text);
+
+    // Returns what text.findCharacterPos(index) would; index may equal the length of the string.
+    PxVec2 get_position(const sf::Text& text, size_t index) const;
+
+    // Returns the index of the character that is closest to the specified point.
+    // Note that the returned index is end-inclusive:
+    // if the point is beyond the final character, the text's length is returned instead
+    // (this specialized behaviour for InputString's end-inclusive indexing).
+    size_t find_index(const sf::Text& text, PxVec2 point) const;
+
+private:
+    std::vector<Px> offsets; // Local offset of every character, followed by the string's end.
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// sf::Font rasterizes each glyph the first time it is drawn in a given size, style and outline,
+// and then re-uploads its glyph texture; the frame that first shows a text hitches.
+// Texts queue the glyphs they will show while a level is loaded; prewarm() then rasterizes them
+// all at once, before the level is played.
+class GlyphPrewarmer
+{
+public:
+    static GlyphPrewarmer& instance()
+    {
+        static GlyphPrewarmer singleton;
+        return singleton;
+    }
+
+    void queue(const TextProps& props, const sf::String& str);
+
+    // Rasterizes all queued glyphs and clears the queue.
+    void prewarm();
+
+private:
+    // A combination of font, size, boldness and outline; each is rasterized separately.
+    struct GlyphStyle
+    {
+        const sf::Font* font;
+        unsigned int size;
+        bool bold;
+        float outline_thickness;
+
+        bool operator<(const GlyphStyle& other) const;
+    };
+
+    struct GlyphGroup
+    {
+        FontReference font; // Keeps the font loaded until it is prewarmed.
+        std::set<sf::Uint32> characters;
+    };
+
+    std::map<GlyphStyle, GlyphGroup> queued_groups;
+
+private:
+    GlyphPrewarmer() = default;
+    ~GlyphPrewarmer() = default;
+    GlyphPrewarmer(const GlyphPrewarmer&) = delete;
+    GlyphPrewarmer(GlyphPrewarmer&&) = delete;
+    GlyphPrewarmer& operator=(const GlyphPrewarmer&) = delete;
+    GlyphPrewarmer& operator=(GlyphPrewarmer&&) = delete;
+};
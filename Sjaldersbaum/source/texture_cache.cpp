@@ -0,0 +1,191 @@
+#include "texture_cache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+#include "lz4.h"
+#include "archive.h"
+#include "rm.h"
+#include "logger.h"
+
+namespace fs = std::filesystem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+const std::string TEXTURE_CACHE_DIRECTORY = "cache/textures/";
+
+// Small images decode quickly enough; caching them would only add file operations.
+constexpr std::uintmax_t MIN_CACHED_FILE_SIZE = 64u * 1024u;
+
+constexpr char          CACHE_MAGIC[4] = { 'S', 'J', 'T', 'C' };
+constexpr std::uint32_t CACHE_VERSION  = 1u;
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct CacheHeader
+{
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t source_size;
+    std::int64_t  source_write_time;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t compressed_size;
+    std::uint64_t path_length; // The source path follows the header (guards against collisions).
+};
+
+std::string get_cache_path(const std::string& path)
+{
+    std::stringstream buffer;
+    buffer << TEXTURE_CACHE_DIRECTORY << std::hex << std::setw(16) << std::setfill('0')
+           << std::hash<std::string>{}(path) << ".lz4";
+    return buffer.str();
+}
+
+bool read_cached_image(sf::Image& image, const std::string& path,
+                       const std::uint64_t source_size, const std::int64_t source_write_time)
+{
+    const std::string cache_path = get_cache_path(path);
+
+    std::error_code error;
+    const std::uintmax_t file_size = fs::file_size(cache_path, error);
+    if (error || file_size < sizeof(CacheHeader))
+        return false;
+
+    std::ifstream file{ cache_path, std::ios_base::in | std::ios_base::binary };
+    if (!file)
+        return false;
+
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version           != CACHE_VERSION ||
+        header.source_size       != source_size   ||
+        header.source_write_time != source_write_time ||
+        header.path_length       != path.size())
+        return false;
+
+    // A damaged entry may still pass the checks above; its sizes must not be trusted blindly:
+    static const unsigned int max_texture_size = sf::Texture::getMaximumSize();
+    if (header.path_length     > file_size - sizeof(header) ||
+        header.compressed_size > file_size - sizeof(header) - header.path_length ||
+        header.width  == 0u || header.width  > max_texture_size ||
+        header.height == 0u || header.height > max_texture_size)
+    {
+        LOG_ALERT("corrupted texture cache entry will be replaced:\n" + path);
+        return false;
+    }
+
+    std::string cached_path(static_cast<size_t>(header.path_length), '\0');
+    if (!file.read(cached_path.data(), cached_path.size()) || cached_path != path)
+        return false;
+
+    std::vector<std::uint8_t> compressed(static_cast<size_t>(header.compressed_size));
+    if (!file.read(reinterpret_cast<char*>(compressed.data()), compressed.size()))
+        return false;
+
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(header.width) * header.height * 4u);
+    if (!LZ4::decompress(compressed.data(), compressed.size(), pixels.data(), pixels.size()))
+    {
+        LOG_ALERT("corrupted texture cache entry will be replaced:\n" + path);
+        return false;
+    }
+
+    image.create(header.width, header.height, pixels.data());
+    return true;
+}
+
+void write_cached_image(const sf::Image& image, const std::string& path,
+                        const std::uint64_t source_size, const std::int64_t source_write_time)
+{
+    std::error_code error;
+    fs::create_directories(TEXTURE_CACHE_DIRECTORY, error);
+    if (error)
+    {
+        LOG_ALERT("texture cache directory could not be created: " + error.message());
+        return;
+    }
+
+    const std::size_t pixel_count = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+    const std::vector<std::uint8_t> compressed = LZ4::compress(image.getPixelsPtr(), pixel_count * 4u);
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version           = CACHE_VERSION;
+    header.source_size       = source_size;
+    header.source_write_time = source_write_time;
+    header.width             = image.getSize().x;
+    header.height            = image.getSize().y;
+    header.compressed_size   = compressed.size();
+    header.path_length       = path.size();
+
+    // Write to a temporary file first, so an interrupted write never leaves a truncated entry.
+    // Workers may cache the same path at once, so each write gets a file of its own:
+    static std::atomic<unsigned int> temporary_count{ 0u };
+    const std::string cache_path     = get_cache_path(path);
+    const std::string temporary_path = cache_path + '.' + Convert::to_str(++temporary_count) + ".tmp";
+    {
+        std::ofstream file{ temporary_path,
+                            std::ios_base::out | std::ios_base::binary | std::ios_base::trunc };
+        if (!file)
+            return;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(path.data(), path.size());
+        file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        if (!file)
+            return;
+    }
+
+    fs::rename(temporary_path, cache_path, error);
+    if (error)
+        fs::remove(temporary_path, error);
+    else if (RESOURCE_LOGGING)
+        LOG_DEBUG("CACHED: " + path);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool load_image(sf::Image& image, const std::string& path)
+{
+    // Archived images are already in memory; the cache only spares decoding loose files.
+    if (const ArchivedFile* file = Archive::instance().find(path))
+        return image.loadFromMemory(file->data, file->size);
+
+    std::error_code error;
+    const std::uintmax_t source_size = fs::file_size(path, error);
+    const fs::file_time_type source_write_time = error ? fs::file_time_type{} :
+                                                         fs::last_write_time(path, error);
+
+    if (error || source_size < MIN_CACHED_FILE_SIZE)
+        return image.loadFromFile(path);
+
+    const std::int64_t write_time = static_cast<std::int64_t>(
+        source_write_time.time_since_epoch().count());
+
+    if (read_cached_image(image, path, source_size, write_time))
+        return true;
+
+    if (!image.loadFromFile(path))
+        return false;
+
+    write_cached_image(image, path, source_size, write_time);
+    return true;
+}
+
+bool load_texture(sf::Texture& texture, const std::string& path)
+{
+    sf::Image image;
+    if (!load_image(image, path))
+        return false;
+
+    return texture.loadFromImage(image);
+}
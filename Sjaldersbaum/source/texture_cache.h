@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <SFML/Graphics.hpp>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Decoding large PNGs dominates level loading, so decoded pixels of large images are kept
+// on disk (LZ4-compressed), keyed by the source's path, size and last write time.
+
+// Loads an image from path; uses its cached pixels if they are up to date,
+// otherwise decodes the file and (re)caches the result. Archived images are decoded from memory.
+bool load_image(sf::Image& image, const std::string& path);
+
+// Loads an image (see load_image) and uploads it to texture.
+bool load_texture(sf::Texture& texture, const std::string& path);
@@ -0,0 +1,58 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Decoding is mostly I/O and inflate; a couple of workers suffice and leave cores for rendering.
+constexpr unsigned int MAX_WORKER_COUNT = 2u;
+
+/*------------------------------------------------------------------------------------------------*/
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool singleton;
+    return singleton;
+}
+
+ThreadPool::ThreadPool() :
+    stopping{ false }
+{
+    const unsigned int worker_count =
+        std::clamp(std::thread::hardware_concurrency() / 2u, 1u, MAX_WORKER_COUNT);
+
+    for (unsigned int i = 0u; i < worker_count; ++i)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{ mutex };
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{ mutex };
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            // Remaining tasks are still finished, since their futures may be waited upon:
+            if (tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Small pool of worker threads for decoding resources (and opening music) off the main thread.
+// Tasks must not touch OpenGL objects, nor OpenAL objects that are in use elsewhere;
+// their results are taken over on the main thread.
+class ThreadPool
+{
+public:
+    static ThreadPool& instance();
+
+    // Queues task; its result (or exception) can be retrieved from the returned future.
+    template<typename Task>
+    auto submit(Task&& task) -> std::future<decltype(task())>;
+
+private:
+    void work();
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+// Implementation:
+
+template<typename Task>
+inline auto ThreadPool::submit(Task&& task) -> std::future<decltype(task())>
+{
+    using Result = decltype(task());
+
+    // std::function requires copyable targets, hence the shared_ptr:
+    auto packaged_task = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+    std::future<Result> future = packaged_task->get_future();
+    {
+        std::lock_guard lock{ mutex };
+        tasks.emplace([packaged_task]() { (*packaged_task)(); });
+    }
+    condition.notify_one();
+
+    return future;
+}
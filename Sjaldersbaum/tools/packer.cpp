@@ -0,0 +1,146 @@
+// Packs the resources that the ResourceManagers/AudioPlayer load into a single archive,
+// which the game memory-maps at startup (see source/archive.h).
+//
+// Usage: packer <resources directory> <archive path>
+// e.g.:  packer Sjaldersbaum/resources Install/Sjaldersbaum/resources.pak
+//
+// Archived paths are relative to the parent of the resources directory ("resources/fonts/...").
+// Levels and shaders are not packed; they are read as text and remain loose files.
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "archive.h"
+#include "string_assist.h"
+
+namespace fs = std::filesystem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+const std::vector<std::string> PACKED_EXTENSIONS =
+{
+    ".png", ".jpg", ".jpeg", ".bmp", ".tga", // textures
+    ".ttf", ".otf",                          // fonts
+    ".ogg", ".wav", ".flac"                  // sounds
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+bool is_packed(const fs::path& path)
+{
+    const std::string extension = get_decapitalized(path.extension().string());
+    return std::find(PACKED_EXTENSIONS.begin(), PACKED_EXTENSIONS.end(), extension) !=
+           PACKED_EXTENSIONS.end();
+}
+
+bool read_file(const fs::path& path, std::vector<char>& contents)
+{
+    std::ifstream file{ path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate };
+    if (!file)
+        return false;
+
+    contents.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    return static_cast<bool>(file.read(contents.data(), contents.size()));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: packer <resources directory> <archive path>\n";
+        return 1;
+    }
+
+    const fs::path resources_directory = fs::path{ argv[1] }.lexically_normal();
+    const fs::path archive_path{ argv[2] };
+    const fs::path base_directory = resources_directory.parent_path();
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& file : fs::recursive_directory_iterator{ resources_directory, error })
+        if (file.is_regular_file() && is_packed(file.path()))
+            paths.push_back(file.path().lexically_relative(base_directory).generic_string());
+
+    if (error)
+    {
+        std::cerr << "resources directory could not be read: " << error.message() << '\n';
+        return 1;
+    }
+
+    // Deterministic output, so that unchanged resources produce identical archives:
+    std::sort(paths.begin(), paths.end());
+
+    std::ofstream archive{ archive_path,
+                           std::ios_base::out | std::ios_base::binary | std::ios_base::trunc };
+    if (!archive)
+    {
+        std::cerr << "archive could not be created: " << archive_path << '\n';
+        return 1;
+    }
+
+    ArchiveHeader header;
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version      = ARCHIVE_VERSION;
+    header.entry_count  = paths.size();
+    header.index_offset = 0u; // Rewritten once the contents are written.
+    archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<ArchiveEntry> entries;
+    std::uint64_t offset = sizeof(header);
+    std::vector<char> contents;
+    for (const auto& path : paths)
+    {
+        if (!read_file(base_directory / path, contents))
+        {
+            std::cerr << "file could not be read: " << path << '\n';
+            return 1;
+        }
+        archive.write(contents.data(), contents.size());
+
+        ArchiveEntry entry;
+        entry.data_offset = offset;
+        entry.data_size   = contents.size();
+        entries.push_back(entry);
+
+        offset += contents.size();
+    }
+
+    header.index_offset = offset;
+    offset += entries.size() * sizeof(ArchiveEntry);
+    for (size_t i = 0u; i < entries.size(); ++i)
+    {
+        const std::string key = get_decapitalized(paths[i]);
+
+        entries[i].path_offset = offset;
+        entries[i].path_length = key.size();
+        offset += key.size();
+    }
+
+    archive.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArchiveEntry));
+    for (const auto& path : paths)
+    {
+        const std::string key = get_decapitalized(path);
+        archive.write(key.data(), key.size());
+    }
+
+    archive.seekp(0);
+    archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!archive)
+    {
+        std::cerr << "archive could not be written: " << archive_path << '\n';
+        return 1;
+    }
+
+    std::cout << "packed " << paths.size() << " files (" << offset / 1024u << " KiB) into "
+              << archive_path << '\n';
+    return 0;
+}
@@ -6,6 +6,15 @@ Copy-Item -Path ".\build\Release\*" -Include "*.dll" -Destination ".\Install\Sja
 Copy-Item -Path ".\LICENSE.txt" -Destination ".\Install\Sjaldersbaum"
 
 Copy-Item -Path ".\Sjaldersbaum\resources" -Destination ".\Install\Sjaldersbaum" -Recurse
+& ".\build\Release\packer.exe" ".\Sjaldersbaum\resources" ".\Install\Sjaldersbaum\resources.pak"
+
+# Textures, fonts and sounds are served from the archive (see PACKED_EXTENSIONS in packer.cpp);
+# only the files it does not contain (levels, shaders, licenses, ...) ship loose:
+if (Test-Path ".\Install\Sjaldersbaum\resources.pak")
+{
+    Remove-Item -Path ".\Install\Sjaldersbaum\resources" -Recurse `
+        -Include "*.png", "*.jpg", "*.jpeg", "*.bmp", "*.tga", "*.ttf", "*.otf", "*.ogg", "*.wav", "*.flac"
+}
 
 Remove-Item -Path ".\Install\Sjaldersbaum" -Include "*.xcf" -Recurse
 Remove-Item -Path ".\Install\Sjaldersbaum\resources\reminders" -Recurse